@@ -43,7 +43,7 @@
 QT_BEGIN_NAMESPACE
 
 QV4ProfilerAdapter::QV4ProfilerAdapter(QQmlProfilerService *service, QV4::ExecutionEngine *engine) :
-    m_functionCallPos(0), m_memoryPos(0)
+    m_functionCallPos(0), m_memoryPos(0), m_gcPos(0)
 {
     setService(service);
     engine->setProfiler(new QV4::Profiling::Profiler(engine));
@@ -71,17 +71,39 @@ QV4ProfilerAdapter::QV4ProfilerAdapter(QQmlProfilerService *service, QV4::Execut
 qint64 QV4ProfilerAdapter::appendMemoryEvents(qint64 until, QList<QByteArray> &messages,
                                               QQmlDebugPacket &d)
 {
-    // Make it const, so that we cannot accidentally detach it.
+    // Make them const, so that we cannot accidentally detach them.
     const QVector<QV4::Profiling::MemoryAllocationProperties> &memoryData = m_memoryData;
+    const QVector<QV4::Profiling::GarbageCollectionProperties> &gcData = m_gcData;
 
-    while (memoryData.length() > m_memoryPos && memoryData[m_memoryPos].timestamp <= until) {
-        const QV4::Profiling::MemoryAllocationProperties &props = memoryData[m_memoryPos];
-        d << props.timestamp << int(MemoryAllocation) << int(props.type) << props.size;
-        ++m_memoryPos;
+    // Both lists are sorted by time. Merge them, so that the timestamps don't go backwards.
+    while (true) {
+        const qint64 memoryNext = memoryData.length() > m_memoryPos
+                ? memoryData[m_memoryPos].timestamp : -1;
+        const qint64 gcNext = gcData.length() > m_gcPos ? gcData[m_gcPos].start : -1;
+
+        if (gcNext != -1 && gcNext <= until && (memoryNext == -1 || gcNext <= memoryNext)) {
+            const QV4::Profiling::GarbageCollectionProperties &props = gcData[m_gcPos];
+            const QV4::GCStatistics &stats = props.statistics;
+            d << props.start << int(GarbageCollection) << int(stats.trigger)
+              << stats.minorCollection << stats.incremental
+              << stats.markTime << stats.sweepTime
+              << qint64(stats.usedBefore) << qint64(stats.usedAfter)
+              << qint64(stats.largeItemsBefore) << qint64(stats.largeItemsAfter)
+              << qint64(stats.chunks) << qint64(stats.releasedChunks)
+              << qint64(stats.unmanagedHeapBefore) << qint64(stats.unmanagedHeapAfter);
+            ++m_gcPos;
+        } else if (memoryNext != -1 && memoryNext <= until) {
+            const QV4::Profiling::MemoryAllocationProperties &props = memoryData[m_memoryPos];
+            d << props.timestamp << int(MemoryAllocation) << int(props.type) << props.size;
+            ++m_memoryPos;
+        } else {
+            if (memoryNext == -1)
+                return gcNext;
+            return gcNext == -1 ? memoryNext : qMin(memoryNext, gcNext);
+        }
         messages.append(d.squeezedData());
         d.clear();
     }
-    return memoryData.length() == m_memoryPos ? -1 : memoryData[m_memoryPos].timestamp;
 }
 
 qint64 QV4ProfilerAdapter::finalizeMessages(qint64 until, QList<QByteArray> &messages,
@@ -98,6 +120,8 @@ qint64 QV4ProfilerAdapter::finalizeMessages(qint64 until, QList<QByteArray> &mes
     if (memoryNext == -1) {
         m_memoryData.clear();
         m_memoryPos = 0;
+        m_gcData.clear();
+        m_gcPos = 0;
         return callNext;
     }
 
@@ -166,7 +190,8 @@ qint64 QV4ProfilerAdapter::sendMessages(qint64 until, QList<QByteArray> &message
 void QV4ProfilerAdapter::receiveData(
         const QV4::Profiling::FunctionLocationHash &locations,
         const QVector<QV4::Profiling::FunctionCallProperties> &functionCallData,
-        const QVector<QV4::Profiling::MemoryAllocationProperties> &memoryData)
+        const QVector<QV4::Profiling::MemoryAllocationProperties> &memoryData,
+        const QVector<QV4::Profiling::GarbageCollectionProperties> &gcData)
 {
     // In rare cases it could be that another flush or stop event is processed while data from
     // the previous one is still pending. In that case we just append the data.
@@ -185,6 +210,11 @@ void QV4ProfilerAdapter::receiveData(
     else
         m_memoryData.append(memoryData);
 
+    if (m_gcData.isEmpty())
+        m_gcData = gcData;
+    else
+        m_gcData.append(gcData);
+
     service->dataReady(this);
 }
 
@@ -195,7 +225,8 @@ quint64 QV4ProfilerAdapter::translateFeatures(quint64 qmlFeatures)
     if (qmlFeatures & (one << ProfileJavaScript))
         v4Features |= (one << QV4::Profiling::FeatureFunctionCall);
     if (qmlFeatures & (one << ProfileMemory))
-        v4Features |= (one << QV4::Profiling::FeatureMemoryAllocation);
+        v4Features |= (one << QV4::Profiling::FeatureMemoryAllocation)
+                | (one << QV4::Profiling::FeatureGarbageCollection);
     return v4Features;
 }
 
@@ -148,6 +148,12 @@ QV4::CompiledData::CompilationUnit *QQmlTypeCompiler::compile()
         QQmlJavaScriptBindingExpressionSimplificationPass pass(document->objects, &document->jsModule, &document->jsGenerator);
         pass.reduceTranslationBindings();
 
+        // Bindings that don't run JavaScript can't hit breakpoints.
+        if (!document->jsModule.debugMode) {
+            QQmlPropertyReadBindingAnnotator propertyReadAnnotator(this);
+            propertyReadAnnotator.annotatePropertyReadBindings();
+        }
+
         QV4::ExecutionEngine *v4 = engine->v4engine();
         QScopedPointer<QV4::EvalInstructionSelection> isel(v4->iselFactory->create(engine, v4->executableAllocator, &document->jsModule, &document->jsGenerator));
         isel->setUseFastLookups(false);
@@ -1451,4 +1457,154 @@ void QQmlDefaultPropertyMerger::mergeDefaultProperties(int objectIndex)
     }
 }
 
+QQmlPropertyReadBindingAnnotator::QQmlPropertyReadBindingAnnotator(QQmlTypeCompiler *typeCompiler)
+    : QQmlCompilePass(typeCompiler)
+    , qmlObjects(*typeCompiler->qmlObjects())
+    , propertyCaches(typeCompiler->propertyCaches())
+    , jsModule(typeCompiler->jsIRModule())
+{
+}
+
+// Types that survive the round trip through a JavaScript value unchanged.
+static bool canCopyPropertyType(int type)
+{
+    switch (type) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Double:
+    case QMetaType::Float:
+    case QMetaType::QString:
+    case QMetaType::QColor:
+    case QMetaType::QPointF:
+    case QMetaType::QSizeF:
+    case QMetaType::QRectF:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void QQmlPropertyReadBindingAnnotator::annotatePropertyReadBindings()
+{
+    for (int i = 0; i < qmlObjects.count(); ++i) {
+        QQmlPropertyCache *propertyCache = propertyCaches->at(i);
+        if (!propertyCache)
+            continue;
+
+        const QmlIR::Object *obj = qmlObjects.at(i);
+        QmlIR::PropertyResolver resolver(propertyCache);
+
+        for (QmlIR::Binding *binding = obj->firstBinding(); binding; binding = binding->next) {
+            if (binding->type != QV4::CompiledData::Binding::Type_Script
+                || !binding->isValueBindingNoAlias()
+                || binding->flags & (QV4::CompiledData::Binding::IsOnAssignment
+                                     | QV4::CompiledData::Binding::IsCustomParserBinding)
+                || binding->propertyNameIndex == quint32(0))
+                continue;
+
+            bool notInRevision = false;
+            const QQmlPropertyData *target = resolver.property(stringAt(binding->propertyNameIndex), &notInRevision);
+            if (!target || notInRevision || !target->isWritable() || !canCopyPropertyType(target->propType()))
+                continue;
+
+            const int irFunctionIndex = obj->runtimeFunctionIndices.at(binding->value.compiledScriptIndex);
+            QV4::IR::Function *irFunction = jsModule->functions.at(irFunctionIndex);
+            if (!irFunction)
+                continue;
+
+            int idIndex = -1;
+            const QQmlPropertyData *source = sourceProperty(irFunction, &idIndex);
+            if (!source || source->propType() != target->propType()
+                || source->isAlias() || source->isVarProperty()
+                || (source->notifyIndex() == -1 && !source->isConstant())
+                || source->coreIndex() >= QV4::CompiledData::Binding::NoSourceId
+                || idIndex >= QV4::CompiledData::Binding::NoSourceId)
+                continue;
+
+            binding->flags |= QV4::CompiledData::Binding::IsPropertyReadBinding;
+            binding->value.propertyRead.sourceIdIndex = idIndex == -1 ? quint16(QV4::CompiledData::Binding::NoSourceId) : quint16(idIndex);
+            binding->value.propertyRead.sourcePropertyIndex = source->coreIndex();
+        }
+    }
+}
+
+static QV4::IR::Expr *valueOfTemp(const QHash<int, QV4::IR::Expr *> &temps, QV4::IR::Temp *temp)
+{
+    QV4::IR::Expr *value = temp;
+    for (int i = 0; i < temps.count() && value; ++i) {
+        QV4::IR::Temp *t = value->asTemp();
+        if (!t)
+            return value;
+        value = temps.value(t->index);
+    }
+    return 0;
+}
+
+const QQmlPropertyData *QQmlPropertyReadBindingAnnotator::sourceProperty(QV4::IR::Function *function, int *idIndex) const
+{
+    // A binding like "foo.width" is generated as a few moves into virtual registers, followed
+    // by returning one of them. Anything with calls, operators or branches stays JavaScript.
+    QHash<int, QV4::IR::Expr *> temps;
+    QV4::IR::Temp *returnValue = 0;
+    for (QV4::IR::BasicBlock *bb : function->basicBlocks()) {
+        for (QV4::IR::Stmt *s : bb->statements()) {
+            if (QV4::IR::Move *move = s->asMove()) {
+                QV4::IR::Temp *target = move->target->asTemp();
+                if (!target || target->kind != QV4::IR::Temp::VirtualRegister)
+                    return 0;
+                if (QV4::IR::Name *n = move->source->asName()) {
+                    if (n->builtin != QV4::IR::Name::builtin_qml_context
+                        && n->builtin != QV4::IR::Name::builtin_qml_imported_scripts_object)
+                        return 0;
+                } else if (!move->source->asMember() && !move->source->asTemp() && !move->source->asConst()) {
+                    return 0;
+                }
+                temps[target->index] = move->source;
+            } else if (QV4::IR::Ret *ret = s->asRet()) {
+                if (returnValue)
+                    return 0;
+                returnValue = ret->expr->asTemp();
+                if (!returnValue)
+                    return 0;
+            } else if (!s->asJump()) {
+                return 0;
+            }
+        }
+    }
+
+    if (!returnValue)
+        return 0;
+    QV4::IR::Expr *value = valueOfTemp(temps, returnValue);
+    QV4::IR::Member *member = value ? value->asMember() : 0;
+    if (!member)
+        return 0;
+
+    if (member->kind == QV4::IR::Member::MemberOfQmlScopeObject) {
+        *idIndex = -1;
+        return member->property;
+    }
+
+    if (member->kind != QV4::IR::Member::UnspecifiedMember)
+        return 0;
+
+    // The code generator attaches a resolver for the id object's property cache to the base
+    // and treats all its properties as final, see QmlIR::JSCodeGen::fallbackNameLookup().
+    QV4::IR::Temp *base = member->base->asTemp();
+    if (!base || !base->memberResolver || !base->memberResolver->isValid())
+        return 0;
+    QV4::IR::Expr *baseValue = valueOfTemp(temps, base);
+    QV4::IR::Member *idMember = baseValue ? baseValue->asMember() : 0;
+    if (!idMember || idMember->kind != QV4::IR::Member::MemberOfIdObjectsArray)
+        return 0;
+
+    QQmlPropertyCache *cache = static_cast<QQmlPropertyCache *>(base->memberResolver->data);
+    QQmlPropertyData *property = cache->property(*member->name, /*object*/0, /*context*/0);
+    if (!property || property->isFunction() || !cache->isAllowedInRevision(property))
+        return 0;
+
+    *idIndex = idMember->idIndex;
+    return property;
+}
+
 QT_END_NAMESPACE
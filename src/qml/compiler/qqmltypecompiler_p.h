@@ -345,6 +345,24 @@ private:
     const QQmlPropertyCacheVector * const propertyCaches;
 };
 
+// Annotate bindings whose expression only reads a property of the scope object or of an
+// object with an id, and the property has the same type as the one bound to. The object
+// creator installs a binding for them that copies the value without running JavaScript.
+class QQmlPropertyReadBindingAnnotator : public QQmlCompilePass
+{
+public:
+    QQmlPropertyReadBindingAnnotator(QQmlTypeCompiler *typeCompiler);
+
+    void annotatePropertyReadBindings();
+
+private:
+    const QQmlPropertyData *sourceProperty(QV4::IR::Function *function, int *idIndex) const;
+
+    const QVector<QmlIR::Object*> &qmlObjects;
+    const QQmlPropertyCacheVector * const propertyCaches;
+    QV4::IR::Module * const jsModule;
+};
+
 QT_END_NAMESPACE
 
 #endif // QQMLTYPECOMPILER_P_H
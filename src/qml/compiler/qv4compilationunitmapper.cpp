@@ -43,6 +43,10 @@
 #include <QFileInfo>
 #include <QDateTime>
 #include <QCoreApplication>
+#include <QDir>
+#include <QVector>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -91,4 +95,107 @@ bool CompilationUnitMapper::verifyHeader(const CompiledData::Unit *header, QDate
     return true;
 }
 
+namespace {
+
+class BundleRegistry
+{
+public:
+    BundleRegistry();
+    ~BundleRegistry() { qDeleteAll(files); }
+
+    const CompiledData::UnitBundle::Entry *find(const QByteArray &sourcePath, const CompiledData::UnitBundle **bundle) const;
+
+private:
+    static bool isValid(const CompiledData::UnitBundle *bundle, qint64 size);
+
+    QVector<QFile *> files;
+    QVector<const CompiledData::UnitBundle *> bundles;
+};
+
+BundleRegistry::BundleRegistry()
+{
+    const QString paths = QString::fromLocal8Bit(qgetenv("QML_DISK_CACHE_BUNDLES"));
+    for (const QString &path : paths.split(QDir::listSeparator(), QString::SkipEmptyParts)) {
+        QFile *file = new QFile(path);
+        uchar *data = nullptr;
+        if (file->open(QIODevice::ReadOnly))
+            data = file->map(/*offset*/0, file->size());
+
+        const CompiledData::UnitBundle *bundle = reinterpret_cast<const CompiledData::UnitBundle *>(data);
+        if (!bundle || !isValid(bundle, file->size())) {
+            delete file;
+            continue;
+        }
+
+        files.append(file);
+        bundles.append(bundle);
+    }
+}
+
+bool BundleRegistry::isValid(const CompiledData::UnitBundle *bundle, qint64 size)
+{
+    if (size < qint64(sizeof(CompiledData::UnitBundle))
+            || strncmp(bundle->magic, CompiledData::bundle_magic_str, sizeof(bundle->magic))
+            || bundle->version != quint32(QV4_DATA_STRUCTURE_VERSION)
+            || bundle->qtVersion != quint32(QT_VERSION)) {
+        return false;
+    }
+
+    if (bundle->offsetToEntries + qint64(bundle->entryCount) * qint64(sizeof(CompiledData::UnitBundle::Entry)) > size)
+        return false;
+
+    for (uint i = 0; i < bundle->entryCount; ++i) {
+        const CompiledData::UnitBundle::Entry *entry = bundle->entryAt(i);
+        if (qint64(entry->pathOffset) + entry->pathSize > size
+                || qint64(entry->unitOffset) + entry->unitSize > size
+                || entry->unitSize < sizeof(CompiledData::Unit)
+                || bundle->unitAt(entry)->unitSize > entry->unitSize) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const CompiledData::UnitBundle::Entry *BundleRegistry::find(const QByteArray &sourcePath, const CompiledData::UnitBundle **bundle) const
+{
+    for (const CompiledData::UnitBundle *candidate : bundles) {
+        const auto pathLessThan = [candidate](const CompiledData::UnitBundle::Entry &entry, const QByteArray &path) {
+            const int length = qMin<int>(entry.pathSize, path.size());
+            const int cmp = memcmp(candidate->pathAt(&entry), path.constData(), length);
+            return cmp < 0 || (cmp == 0 && int(entry.pathSize) < path.size());
+        };
+
+        const CompiledData::UnitBundle::Entry *begin = candidate->entryAt(0);
+        const CompiledData::UnitBundle::Entry *end = begin + candidate->entryCount;
+        const CompiledData::UnitBundle::Entry *entry = std::lower_bound(begin, end, sourcePath, pathLessThan);
+        if (entry != end && int(entry->pathSize) == sourcePath.size()
+                && memcmp(candidate->pathAt(entry), sourcePath.constData(), sourcePath.size()) == 0) {
+            *bundle = candidate;
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+}
+
+Q_GLOBAL_STATIC(BundleRegistry, bundleRegistry)
+
+CompiledData::Unit *CompilationUnitMapper::openFromBundle(const QString &sourcePath, const QDateTime &sourceTimeStamp, QString *errorString)
+{
+    const CompiledData::UnitBundle *bundle = nullptr;
+    const CompiledData::UnitBundle::Entry *entry = bundleRegistry()->find(sourcePath.toUtf8(), &bundle);
+    if (!entry) {
+        *errorString = QStringLiteral("No bundled cache found for source file.");
+        return nullptr;
+    }
+
+    const CompiledData::Unit *unit = bundle->unitAt(entry);
+    if (!verifyHeader(unit, sourceTimeStamp, errorString))
+        return nullptr;
+
+    return const_cast<CompiledData::Unit *>(unit);
+}
+
 QT_END_NAMESPACE
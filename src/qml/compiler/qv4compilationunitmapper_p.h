@@ -71,6 +71,10 @@ public:
     CompiledData::Unit *open(const QString &cacheFilePath, const QDateTime &sourceTimeStamp, QString *errorString);
     void close();
 
+    // Looks up the unit for the given source in the bundles listed in QML_DISK_CACHE_BUNDLES.
+    // Bundles stay mapped for the lifetime of the process.
+    static CompiledData::Unit *openFromBundle(const QString &sourcePath, const QDateTime &sourceTimeStamp, QString *errorString);
+
 private:
     static bool verifyHeader(const QV4::CompiledData::Unit *header, QDateTime sourceTimeStamp, QString *errorString);
 
@@ -42,6 +42,7 @@
 #include <private/qv4value_p.h>
 #ifndef V4_BOOTSTRAP
 #include <private/qv4engine_p.h>
+#include <private/qv4identifiertable_p.h>
 #include <private/qv4function_p.h>
 #include <private/qv4objectproto_p.h>
 #include <private/qv4lookup_p.h>
@@ -125,8 +126,16 @@ QV4::Function *CompilationUnit::linkToEngine(ExecutionEngine *engine)
     runtimeStrings = (QV4::Heap::String **)malloc(data->stringTableSize * sizeof(QV4::Heap::String*));
     // memset the strings to 0 in case a GC run happens while we're within the loop below
     memset(runtimeStrings, 0, data->stringTableSize * sizeof(QV4::Heap::String*));
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    for (uint i = 0; i < data->stringTableSize; ++i) {
+        const CompiledData::String *str = data->stringEntryAt(i);
+        runtimeStrings[i] = engine->identifierTable->insertString(reinterpret_cast<const QChar *>(str + 1), str->size,
+                                                                  str->hash, str->subtype);
+    }
+#else
     for (uint i = 0; i < data->stringTableSize; ++i)
         runtimeStrings[i] = engine->newIdentifier(data->stringAt(i));
+#endif
 
     runtimeRegularExpressions = new QV4::Value[data->regexpTableSize];
     // memset the regexps to 0 in case a GC run happens while we're within the loop below
@@ -194,10 +203,13 @@ QV4::Function *CompilationUnit::linkToEngine(ExecutionEngine *engine)
     constants = reinterpret_cast<const Value*>(data->constants());
 #endif
 
+    runtimeFunctions.resize(data->functionTableSize);
+    runtimeFunctions.fill(0);
+
     linkBackendToEngine(engine);
 
     if (data->indexOfRootFunction != -1)
-        return runtimeFunctions[data->indexOfRootFunction];
+        return runtimeFunction(data->indexOfRootFunction);
     else
         return 0;
 }
@@ -304,6 +316,12 @@ void CompilationUnit::finalize(QQmlEnginePrivate *engine)
     for (quint32 i = 0; i < data->nObjects; ++i) {
         const QV4::CompiledData::Object *obj = data->objectAt(i);
         bindingCount += obj->nBindings;
+        // Build the meta-objects that QQmlVMEMetaObject is going to install now, while
+        // we are still on the type loader thread, instead of on first instantiation.
+        // Composite base types went through here before us, so their meta-objects
+        // are already complete.
+        if (propertyCaches.needsVMEMetaObject(i))
+            propertyCaches.at(i)->createMetaObject();
         if (auto *typeRef = resolvedTypes.value(obj->inheritedTypeNameIndex)) {
             if (QQmlType *qmlType = typeRef->type) {
                 if (qmlType->parserStatusCast() != -1)
@@ -349,11 +367,16 @@ bool CompilationUnit::loadFromDisk(const QUrl &url, const QDateTime &sourceTimeS
     }
 
     const QString sourcePath = QQmlFile::urlToLocalFileOrQrc(url);
-    QScopedPointer<CompilationUnitMapper> cacheFile(new CompilationUnitMapper());
-
-    CompiledData::Unit *mappedUnit = cacheFile->open(cacheFilePath(url), sourceTimeStamp, errorString);
-    if (!mappedUnit)
-        return false;
+    QScopedPointer<CompilationUnitMapper> cacheFile;
+
+    // Bundled units are owned by the bundle, so they do not need a backing file of their own.
+    CompiledData::Unit *mappedUnit = CompilationUnitMapper::openFromBundle(sourcePath, sourceTimeStamp, errorString);
+    if (!mappedUnit) {
+        cacheFile.reset(new CompilationUnitMapper());
+        mappedUnit = cacheFile->open(cacheFilePath(url), sourceTimeStamp, errorString);
+        if (!mappedUnit)
+            return false;
+    }
 
     const Unit * const oldDataPtr = (data && !(data->flags & QV4::CompiledData::Unit::StaticData)) ? data : nullptr;
     QScopedValueRollback<const Unit *> dataPtrChange(data, mappedUnit);
@@ -71,7 +71,7 @@
 QT_BEGIN_NAMESPACE
 
 // Bump this whenever the compiler data structures change in an incompatible way.
-#define QV4_DATA_STRUCTURE_VERSION 0x11
+#define QV4_DATA_STRUCTURE_VERSION 0x13
 
 class QIODevice;
 class QQmlPropertyCache;
@@ -195,6 +195,10 @@ struct JSClass
 struct String
 {
     LEInt32 size;
+    // Precomputed by QV4::String::createHashValue(), so that the strings can be
+    // interned when linking without hashing them again.
+    LEUInt32 hash;
+    LEUInt32 subtype;
     // uint16 strdata[]
 
     static int calculateSize(const QString &str) {
@@ -297,6 +301,7 @@ struct Q_QML_PRIVATE_EXPORT Binding
         IsBindingToAlias = 0x40,
         IsDeferredBinding = 0x80,
         IsCustomParserBinding = 0x100,
+        IsPropertyReadBinding = 0x200,
     };
 
     union {
@@ -307,6 +312,11 @@ struct Q_QML_PRIVATE_EXPORT Binding
         bool b;
         quint64 doubleValue; // do not access directly, needs endian protected access
         LEUInt32 compiledScriptIndex; // used when Type_Script
+        struct {
+            LEUInt32 compiledScriptIndex;
+            LEUInt16 sourceIdIndex; // NoSourceId for the scope object
+            LEUInt16 sourcePropertyIndex;
+        } propertyRead; // used when Type_Script with IsPropertyReadBinding
         LEUInt32 objectIndex;
         TranslationData translationData; // used when Type_Translation
     } value;
@@ -315,6 +325,8 @@ struct Q_QML_PRIVATE_EXPORT Binding
     Location location;
     Location valueLocation;
 
+    enum { NoSourceId = 0xffff };
+
     bool isValueBinding() const
     {
         if (type == Type_AttachedProperty
@@ -667,10 +679,14 @@ struct Unit
     }
     /* end QML specific fields*/
 
-    QString stringAt(int idx) const {
+    const String *stringEntryAt(int idx) const {
         const LEUInt32 *offsetTable = reinterpret_cast<const LEUInt32*>((reinterpret_cast<const char *>(this)) + offsetToStringTable);
         const LEUInt32 offset = offsetTable[idx];
-        const String *str = reinterpret_cast<const String*>(reinterpret_cast<const char *>(this) + offset);
+        return reinterpret_cast<const String*>(reinterpret_cast<const char *>(this) + offset);
+    }
+
+    QString stringAt(int idx) const {
+        const String *str = stringEntryAt(idx);
         if (str->size == 0)
             return QString();
 #if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
@@ -716,6 +732,40 @@ struct Unit
     }
 };
 
+static const char bundle_magic_str[] = "qv4cbndl";
+
+// A bundle packs the cache files of many sources into one file that is mapped only once. The
+// header is followed by a table of entries sorted by source path, the UTF-8 encoded source paths
+// and the units themselves, each starting at a 16 byte aligned offset.
+struct UnitBundle
+{
+    char magic[8];
+    LEUInt32 version;
+    LEUInt32 qtVersion;
+    LEUInt32 entryCount;
+    LEUInt32 offsetToEntries;
+
+    struct Entry
+    {
+        LEUInt32 pathOffset;
+        LEUInt32 pathSize;
+        LEUInt32 unitOffset;
+        LEUInt32 unitSize; // Size of the whole cache file, including any machine code
+    };
+
+    const Entry *entryAt(int idx) const {
+        return reinterpret_cast<const Entry *>(reinterpret_cast<const char *>(this) + offsetToEntries + idx * sizeof(Entry));
+    }
+
+    const char *pathAt(const Entry *entry) const {
+        return reinterpret_cast<const char *>(this) + entry->pathOffset;
+    }
+
+    const Unit *unitAt(const Entry *entry) const {
+        return reinterpret_cast<const Unit *>(reinterpret_cast<const char *>(this) + entry->unitOffset);
+    }
+};
+
 #if defined(Q_CC_MSVC) || defined(Q_CC_GNU)
 #pragma pack(pop)
 #endif
@@ -832,7 +882,15 @@ struct Q_QML_PRIVATE_EXPORT CompilationUnit : public CompilationUnitBase, public
     QV4::Lookup *runtimeLookups;
     QV4::Value *runtimeRegularExpressions;
     QV4::InternalClass **runtimeClasses;
+    // Entries are created on first use through runtimeFunction().
     QVector<QV4::Function *> runtimeFunctions;
+    QV4::Function *runtimeFunction(int index)
+    {
+        QV4::Function *&function = runtimeFunctions[index];
+        if (!function)
+            function = createRuntimeFunction(index);
+        return function;
+    }
     mutable QQmlNullableValue<QUrl> m_url;
 
     // QML specific fields
@@ -905,6 +963,7 @@ struct Q_QML_PRIVATE_EXPORT CompilationUnit : public CompilationUnitBase, public
 
 protected:
     virtual void linkBackendToEngine(QV4::ExecutionEngine *engine) = 0;
+    virtual QV4::Function *createRuntimeFunction(int index) = 0;
     virtual bool memoryMapCode(QString *errorString);
 #endif // V4_BOOTSTRAP
 
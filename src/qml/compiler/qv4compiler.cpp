@@ -86,6 +86,9 @@ void QV4::Compiler::StringTableGenerator::serialize(CompiledData::Unit *unit)
 
         QV4::CompiledData::String *s = reinterpret_cast<QV4::CompiledData::String *>(stringData);
         s->size = qstr.length();
+        uint subtype;
+        s->hash = QV4::String::createHashValue(qstr.constData(), qstr.length(), &subtype);
+        s->subtype = subtype;
 #if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
         memcpy(s + 1, qstr.constData(), qstr.length()*sizeof(ushort));
 #else
@@ -179,15 +182,10 @@ int QV4::Compiler::JSUnitGenerator::registerConstant(QV4::ReturnedValue v)
 
 int QV4::Compiler::JSUnitGenerator::registerJSClass(int count, IR::ExprList *args)
 {
-    // ### re-use existing class definitions.
-
     const int size = CompiledData::JSClass::calculateSize(count);
-    jsClassOffsets.append(jsClassData.size());
-    const int oldSize = jsClassData.size();
-    jsClassData.resize(jsClassData.size() + size);
-    memset(jsClassData.data() + oldSize, 0, size);
+    QByteArray klassData(size, 0);
 
-    CompiledData::JSClass *jsClass = reinterpret_cast<CompiledData::JSClass*>(jsClassData.data() + oldSize);
+    CompiledData::JSClass *jsClass = reinterpret_cast<CompiledData::JSClass*>(klassData.data());
     jsClass->nMembers = count;
     CompiledData::JSClassMember *member = reinterpret_cast<CompiledData::JSClassMember*>(jsClass + 1);
 
@@ -206,7 +204,18 @@ int QV4::Compiler::JSUnitGenerator::registerJSClass(int count, IR::ExprList *arg
             it = it->next;
     }
 
-    return jsClassOffsets.size() - 1;
+    // Object literals with the same members in the same order share one class, so that
+    // they also share one internal class at run-time.
+    const auto existing = jsClassIndices.constFind(klassData);
+    if (existing != jsClassIndices.constEnd())
+        return existing.value();
+
+    jsClassOffsets.append(jsClassData.size());
+    jsClassData.append(klassData);
+
+    const int index = jsClassOffsets.size() - 1;
+    jsClassIndices.insert(klassData, index);
+    return index;
 }
 
 QV4::CompiledData::Unit *QV4::Compiler::JSUnitGenerator::generateUnit(GeneratorOption option)
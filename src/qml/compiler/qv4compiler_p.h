@@ -129,6 +129,7 @@ private:
     QVector<ReturnedValue> constants;
     QByteArray jsClassData;
     QVector<int> jsClassOffsets;
+    QHash<QByteArray, int> jsClassIndices;
 };
 
 }
@@ -1436,6 +1436,7 @@ CompilationUnit::~CompilationUnit()
 
 void CompilationUnit::linkBackendToEngine(QV4::ExecutionEngine *engine)
 {
+    Q_UNUSED(engine);
 #ifdef MOTH_THREADED_INTERPRETER
     // link byte code against addresses of instructions
     for (int i = 0; i < codeRefs.count(); ++i) {
@@ -1458,16 +1459,15 @@ void CompilationUnit::linkBackendToEngine(QV4::ExecutionEngine *engine)
         }
     }
 #endif
+}
 
-    runtimeFunctions.resize(data->functionTableSize);
-    runtimeFunctions.fill(0);
-    for (int i = 0 ;i < runtimeFunctions.size(); ++i) {
-        const QV4::CompiledData::Function *compiledFunction = data->functionAt(i);
+QV4::Function *CompilationUnit::createRuntimeFunction(int index)
+{
+    const QV4::CompiledData::Function *compiledFunction = data->functionAt(index);
 
-        QV4::Function *runtimeFunction = new QV4::Function(engine, this, compiledFunction, &VME::exec);
-        runtimeFunction->codeData = reinterpret_cast<const uchar *>(codeRefs.at(i).constData());
-        runtimeFunctions[i] = runtimeFunction;
-    }
+    QV4::Function *runtimeFunction = new QV4::Function(engine, this, compiledFunction, &VME::exec);
+    runtimeFunction->codeData = reinterpret_cast<const uchar *>(codeRefs.at(index).constData());
+    return runtimeFunction;
 }
 
 bool CompilationUnit::memoryMapCode(QString *errorString)
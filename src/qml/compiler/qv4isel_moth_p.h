@@ -73,6 +73,7 @@ struct CompilationUnit : public QV4::CompiledData::CompilationUnit
     virtual ~CompilationUnit();
 #if !defined(V4_BOOTSTRAP)
     void linkBackendToEngine(QV4::ExecutionEngine *engine) Q_DECL_OVERRIDE;
+    QV4::Function *createRuntimeFunction(int index) Q_DECL_OVERRIDE;
     bool memoryMapCode(QString *errorString) Q_DECL_OVERRIDE;
 #endif
     void prepareCodeOffsetsForDiskStorage(CompiledData::Unit *unit) Q_DECL_OVERRIDE;
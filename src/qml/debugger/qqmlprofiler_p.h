@@ -84,6 +84,7 @@ struct QQmlHandlingSignalProfiler
 struct QQmlCompilingProfiler
 {
     QQmlCompilingProfiler(quintptr, QQmlDataBlob *) {}
+    QQmlCompilingProfiler(quintptr, const QString &) {}
 };
 
 struct QQmlVmeProfiler {
@@ -218,6 +219,11 @@ public:
             sent(false)
         {}
 
+        RefLocation(const QString &description) :
+            Location(QQmlSourceLocation(description, 0, 0)), locationType(Compiling),
+            ref(nullptr), sent(false)
+        {}
+
         bool isValid() const
         {
             return locationType != MaximumRangeType;
@@ -261,6 +267,23 @@ public:
             location = RefLocation(blob);
     }
 
+    // Compiling work that has no QQmlDataBlob, like resolving a qmldir or loading a plugin.
+    // Equal descriptions share a location. The IDs are small multiples of 4 plus 2, so they
+    // cannot clash with the object pointers and the odd binding IDs used elsewhere.
+    void startCompiling(const QString &description)
+    {
+        quintptr &locationId = m_descriptionIds[description];
+        if (locationId == 0)
+            locationId = (quintptr(m_descriptionIds.size()) << 2) | 2;
+        m_data.append(QQmlProfilerData(m_timer.nsecsElapsed(),
+                                       (1 << RangeStart | 1 << RangeLocation | 1 << RangeData),
+                                       Compiling, locationId));
+
+        RefLocation &location = m_locations[locationId];
+        if (!location.isValid())
+            location = RefLocation(description);
+    }
+
     void startHandlingSignal(QQmlBoundSignalExpression *expression)
     {
         quintptr locationId(id(expression));
@@ -317,6 +340,7 @@ signals:
 protected:
     QElapsedTimer m_timer;
     QHash<quintptr, RefLocation> m_locations;
+    QHash<QString, quintptr> m_descriptionIds;
     QVector<QQmlProfilerData> m_data;
 };
 
@@ -366,6 +390,13 @@ struct QQmlCompilingProfiler : public QQmlProfilerHelper {
         Q_QML_PROFILE(QQmlProfilerDefinitions::ProfileCompiling, profiler, startCompiling(blob));
     }
 
+    QQmlCompilingProfiler(QQmlProfiler *profiler, const QString &description) :
+        QQmlProfilerHelper(profiler)
+    {
+        Q_QML_PROFILE(QQmlProfilerDefinitions::ProfileCompiling, profiler,
+                      startCompiling(description));
+    }
+
     ~QQmlCompilingProfiler()
     {
         Q_QML_PROFILE(QQmlProfilerDefinitions::ProfileCompiling, profiler, endRange<Compiling>());
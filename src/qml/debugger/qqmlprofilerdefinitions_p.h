@@ -69,6 +69,7 @@ struct QQmlProfilerDefinitions {
         PixmapCacheEvent,
         SceneGraphFrame,
         MemoryAllocation,
+        GarbageCollection,
 
         MaximumMessage
     };
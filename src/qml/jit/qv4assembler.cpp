@@ -51,6 +51,7 @@
 #endif
 
 #include <iostream>
+#include <limits>
 #include <QBuffer>
 #include <QCoreApplication>
 
@@ -71,15 +72,14 @@ CompilationUnit::~CompilationUnit()
 
 void CompilationUnit::linkBackendToEngine(ExecutionEngine *engine)
 {
-    runtimeFunctions.resize(data->functionTableSize);
-    runtimeFunctions.fill(0);
-    for (int i = 0 ;i < runtimeFunctions.size(); ++i) {
-        const CompiledData::Function *compiledFunction = data->functionAt(i);
+    Q_UNUSED(engine);
+}
 
-        QV4::Function *runtimeFunction = new QV4::Function(engine, this, compiledFunction,
-                                                           (ReturnedValue (*)(QV4::ExecutionEngine *, const uchar *)) codeRefs[i].code().executableAddress());
-        runtimeFunctions[i] = runtimeFunction;
-    }
+QV4::Function *CompilationUnit::createRuntimeFunction(int index)
+{
+    const CompiledData::Function *compiledFunction = data->functionAt(index);
+    return new QV4::Function(engine, this, compiledFunction,
+                             (ReturnedValue (*)(QV4::ExecutionEngine *, const uchar *)) codeRefs[index].code().executableAddress());
 }
 
 bool CompilationUnit::memoryMapCode(QString *errorString)
@@ -89,13 +89,21 @@ bool CompilationUnit::memoryMapCode(QString *errorString)
 
     const char *basePtr = reinterpret_cast<const char *>(data);
 
+    // The code of all functions is stored back to back at the end of the unit (see
+    // prepareCodeOffsetsForDiskStorage), so make the whole range executable at once
+    // instead of changing the protection of the same pages for every function.
+    quint64 codeStart = std::numeric_limits<quint64>::max();
+    quint64 codeEnd = 0;
+
     for (uint i = 0; i < data->functionTableSize; ++i) {
         const CompiledData::Function *compiledFunction = data->functionAt(i);
         void *codePtr = const_cast<void *>(reinterpret_cast<const void *>(basePtr + compiledFunction->codeOffset));
         JSC::MacroAssemblerCodeRef codeRef = JSC::MacroAssemblerCodeRef::createSelfManagedCodeRef(JSC::MacroAssemblerCodePtr(codePtr));
-        JSC::ExecutableAllocator::makeExecutable(codePtr, compiledFunction->codeSize);
         codeRefs[i] = codeRef;
 
+        codeStart = qMin<quint64>(codeStart, compiledFunction->codeOffset);
+        codeEnd = qMax<quint64>(codeEnd, compiledFunction->codeOffset + compiledFunction->codeSize);
+
         static const bool showCode = qEnvironmentVariableIsSet("QV4_SHOW_ASM");
         if (showCode) {
             WTF::dataLogF("Mapped JIT code for %s\n", qPrintable(stringAt(compiledFunction->nameIndex)));
@@ -103,6 +111,9 @@ bool CompilationUnit::memoryMapCode(QString *errorString)
         }
     }
 
+    if (codeEnd > codeStart)
+        JSC::ExecutableAllocator::makeExecutable(const_cast<char *>(basePtr + codeStart), codeEnd - codeStart);
+
     return true;
 }
 
@@ -462,6 +473,13 @@ typename Assembler<TargetConfiguration>::Jump Assembler<TargetConfiguration>::ge
 template <typename TargetConfiguration>
 typename Assembler<TargetConfiguration>::Jump Assembler<TargetConfiguration>::branchDouble(bool invertCondition, IR::AluOp op,
                                                    IR::Expr *left, IR::Expr *right)
+{
+    return branchDouble(invertCondition, op, toDoubleRegister(left, FPGpr0), toDoubleRegister(right, JITTargetPlatform::FPGpr1));
+}
+
+template <typename TargetConfiguration>
+typename Assembler<TargetConfiguration>::Jump Assembler<TargetConfiguration>::branchDouble(bool invertCondition, IR::AluOp op,
+                                                   FPRegisterID left, FPRegisterID right)
 {
     DoubleCondition cond;
     switch (op) {
@@ -479,7 +497,7 @@ typename Assembler<TargetConfiguration>::Jump Assembler<TargetConfiguration>::br
     if (invertCondition)
         cond = TargetConfiguration::MacroAssembler::invert(cond);
 
-    return TargetConfiguration::MacroAssembler::branchDouble(cond, toDoubleRegister(left, FPGpr0), toDoubleRegister(right, JITTargetPlatform::FPGpr1));
+    return TargetConfiguration::MacroAssembler::branchDouble(cond, left, right);
 }
 
 template <typename TargetConfiguration>
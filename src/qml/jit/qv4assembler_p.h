@@ -81,6 +81,7 @@ struct CompilationUnit : public QV4::CompiledData::CompilationUnit
 
 #if !defined(V4_BOOTSTRAP)
     void linkBackendToEngine(QV4::ExecutionEngine *engine) Q_DECL_OVERRIDE;
+    QV4::Function *createRuntimeFunction(int index) Q_DECL_OVERRIDE;
     bool memoryMapCode(QString *errorString) Q_DECL_OVERRIDE;
 #endif
     void prepareCodeOffsetsForDiskStorage(CompiledData::Unit *unit) Q_DECL_OVERRIDE;
@@ -191,7 +192,20 @@ struct RegisterSizeDependentAssembler<JITAssembler, MacroAssembler, TargetPlatfo
         as->pop(TargetPlatform::EngineRegister);
     }
 
-#if WRITEBARRIER(none)
+#if WRITEBARRIER(steele)
+    static void emitWriteBarrier(JITAssembler *as, Address addr)
+    {
+        RegisterID test = (addr.base == TargetPlatform::ReturnValueRegister) ? TargetPlatform::ScratchRegister : TargetPlatform::ReturnValueRegister;
+        // writeBarrierActive is the byte following hasException, see EngineBase
+        const qint32 writeBarrierActiveOffset = JITAssembler::targetStructureOffset(offsetof(EngineBase, hasException))
+                + (offsetof(EngineBase, writeBarrierActive) - offsetof(EngineBase, hasException));
+        as->load8(Address(TargetPlatform::EngineRegister, writeBarrierActiveOffset), test);
+        Jump inactive = as->branch32(RelationalCondition::Equal, test, TrustedImm32(0));
+        // ### emit fence
+        emitSetGrayBit(as, addr.base);
+        inactive.link(as);
+    }
+#elif WRITEBARRIER(none)
     static Q_ALWAYS_INLINE void emitWriteBarrier(JITAssembler *, Address) {}
 #endif
 
@@ -487,7 +501,20 @@ struct RegisterSizeDependentAssembler<JITAssembler, MacroAssembler, TargetPlatfo
         as->pop(TargetPlatform::EngineRegister);
     }
 
-#if WRITEBARRIER(none)
+#if WRITEBARRIER(steele)
+    static void emitWriteBarrier(JITAssembler *as, Address addr)
+    {
+        RegisterID test = (addr.base == TargetPlatform::ReturnValueRegister) ? TargetPlatform::ScratchRegister : TargetPlatform::ReturnValueRegister;
+        // writeBarrierActive is the byte following hasException, see EngineBase
+        const qint32 writeBarrierActiveOffset = JITAssembler::targetStructureOffset(offsetof(EngineBase, hasException))
+                + (offsetof(EngineBase, writeBarrierActive) - offsetof(EngineBase, hasException));
+        as->load8(Address(TargetPlatform::EngineRegister, writeBarrierActiveOffset), test);
+        Jump inactive = as->branch32(RelationalCondition::Equal, test, TrustedImm32(0));
+        // ### emit fence
+        emitSetGrayBit(as, addr.base);
+        inactive.link(as);
+    }
+#elif WRITEBARRIER(none)
     static Q_ALWAYS_INLINE void emitWriteBarrier(JITAssembler *, Address) {}
 #endif
 
@@ -1096,6 +1123,7 @@ public:
 
     Jump genTryDoubleConversion(IR::Expr *src, FPRegisterID dest);
     Jump branchDouble(bool invertCondition, IR::AluOp op, IR::Expr *left, IR::Expr *right);
+    Jump branchDouble(bool invertCondition, IR::AluOp op, FPRegisterID left, FPRegisterID right);
     Jump branchInt32(bool invertCondition, IR::AluOp op, IR::Expr *left, IR::Expr *right);
 
     Pointer loadAddressForWriting(RegisterID tmp, IR::Expr *t, WriteBarrier::Type *barrier);
@@ -639,6 +639,25 @@ typename JITAssembler::Jump Binop<JITAssembler>::genInlineBinop(IR::Expr *leftSo
         if (rightIsNoDbl.isSet())
             rightIsNoDbl.link(as);
     } break;
+    case IR::OpGt:
+    case IR::OpLt:
+    case IR::OpGe:
+    case IR::OpLe: {
+        Jump leftIsNoDbl, rightIsNoDbl;
+        Jump trueCase = genInlineCompare(leftSource, rightSource, &leftIsNoDbl, &rightIsNoDbl);
+        as->move(TrustedImm32(0), JITAssembler::ReturnValueRegister);
+        Jump storeResult = as->jump();
+        trueCase.link(as);
+        as->move(TrustedImm32(1), JITAssembler::ReturnValueRegister);
+        storeResult.link(as);
+        as->storeBool(JITAssembler::ReturnValueRegister, target);
+        done = as->jump();
+
+        if (leftIsNoDbl.isSet())
+            leftIsNoDbl.link(as);
+        if (rightIsNoDbl.isSet())
+            rightIsNoDbl.link(as);
+    } break;
     default:
         break;
     }
@@ -646,6 +665,25 @@ typename JITAssembler::Jump Binop<JITAssembler>::genInlineBinop(IR::Expr *leftSo
     return done;
 }
 
+// Compares two operands of unknown type as doubles, for the common case where both of them turn
+// out to be numbers at run-time. The returned jump is taken when the comparison holds, and the
+// conversion jumps are taken when an operand is not a number, in which case the caller has to
+// fall back to the generic runtime comparison. Like genInlineBinop, this relies on the register
+// allocator having prepared for a call.
+template <typename JITAssembler>
+typename JITAssembler::Jump Binop<JITAssembler>::genInlineCompare(IR::Expr *leftSource, IR::Expr *rightSource,
+                                                                  Jump *leftIsNoDbl, Jump *rightIsNoDbl)
+{
+    Q_ASSERT(op >= IR::OpGt && op <= IR::OpLe);
+
+    FPRegisterID lReg = getFreeFPReg<JITAssembler>(rightSource, 2);
+    FPRegisterID rReg = getFreeFPReg<JITAssembler>(leftSource, 4);
+    *leftIsNoDbl = as->genTryDoubleConversion(leftSource, lReg);
+    *rightIsNoDbl = as->genTryDoubleConversion(rightSource, rReg);
+
+    return as->branchDouble(false, op, lReg, rReg);
+}
+
 template struct QV4::JIT::Binop<QV4::JIT::Assembler<DefaultAssemblerTargetConfiguration>>;
 #if defined(V4_BOOTSTRAP)
 #if !CPU(ARM_THUMB2)
@@ -1246,6 +1246,22 @@ void InstructionSelection<JITAssembler>::visitCJump(IR::CJump *s)
             return;
         }
 
+        if (b->op >= IR::OpGt && b->op <= IR::OpLe
+                && b->left->type != IR::StringType && b->right->type != IR::StringType) {
+            // Relational operators on untyped operands nearly always see numbers, so compare
+            // those inline and only call into the runtime for anything else.
+            Jump leftIsNoDbl, rightIsNoDbl;
+            QV4::JIT::Binop<JITAssembler> binop(_as, b->op);
+            Jump trueCase = binop.genInlineCompare(b->left, b->right, &leftIsNoDbl, &rightIsNoDbl);
+            _as->addPatch(s->iftrue, trueCase);
+            _as->addPatch(s->iffalse, _as->jump());
+
+            if (leftIsNoDbl.isSet())
+                leftIsNoDbl.link(_as);
+            if (rightIsNoDbl.isSet())
+                rightIsNoDbl.link(_as);
+        }
+
         typename JITAssembler::RuntimeCall op;
         typename JITAssembler::RuntimeCall opContext;
         const char *opName = 0;
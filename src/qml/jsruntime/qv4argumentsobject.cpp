@@ -175,7 +175,7 @@ bool ArgumentsObject::putIndexed(Managed *m, uint index, const Value &value)
     if (args->fullyCreated())
         return Object::putIndexed(m, index, value);
 
-    args->context()->callData->args[index] = value;
+    WriteBarrier::write(args->engine(), args->context(), args->context()->callData->args + index, value);
     return true;
 }
 
@@ -231,7 +231,8 @@ void ArgumentsSetterFunction::call(const Managed *setter, Scope &scope, CallData
     }
 
     Q_ASSERT(s->index() < static_cast<unsigned>(o->context()->callData->argc));
-    o->context()->callData->args[s->index()] = callData->argc ? callData->args[0].asReturnedValue() : Encode::undefined();
+    WriteBarrier::write(scope.engine, o->context(), o->context()->callData->args + s->index(),
+                        Value::fromReturnedValue(callData->argc ? callData->args[0].asReturnedValue() : Encode::undefined()));
     scope.result = Encode::undefined();
 }
 
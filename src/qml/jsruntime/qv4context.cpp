@@ -340,7 +340,12 @@ void ExecutionContext::setProperty(String *name, const Value &value)
                 uint index = c->v4Function->internalClass->find(name);
                 if (index < UINT_MAX) {
                     if (index < c->v4Function->nFormals) {
-                        c->callData->args[c->v4Function->nFormals - index - 1] = value;
+                        Value *arg = c->callData->args + c->v4Function->nFormals - index - 1;
+                        // only the arguments of a full call context live on the heap
+                        if (c->type == Heap::ExecutionContext::Type_CallContext)
+                            WriteBarrier::write(scope.engine, c, arg, value);
+                        else
+                            *arg = value;
                     } else {
                         Q_ASSERT(c->type == Heap::ExecutionContext::Type_CallContext);
                         index -= c->v4Function->nFormals;
@@ -60,6 +60,7 @@
 #include <qv4jsonobject_p.h>
 #include <qv4stringobject_p.h>
 #include <qv4identifiertable_p.h>
+#include "qv4lookup_p.h"
 #include "qv4debugging_p.h"
 #include "qv4profiling_p.h"
 #include "qv4executableallocator_p.h"
@@ -218,6 +219,7 @@ ExecutionEngine::ExecutionEngine(EvalISelFactory *factory)
     identifierTable = new IdentifierTable(this);
 
     classPool = new InternalClassPool;
+    megamorphicLookupCache = new MegamorphicLookupCache;
 
     emptyClass =  new (classPool) InternalClass(this);
 
@@ -492,6 +494,7 @@ ExecutionEngine::~ExecutionEngine()
 
     emptyClass->destroy();
     delete classPool;
+    delete megamorphicLookupCache;
     delete bumperPointerAllocator;
     delete regExpCache;
     delete regExpAllocator;
@@ -86,6 +86,7 @@ struct CompilationUnit;
 
 struct InternalClass;
 struct InternalClassPool;
+struct MegamorphicLookupCache;
 
 struct Q_QML_EXPORT ExecutionEngine : public EngineBase
 {
@@ -240,6 +241,7 @@ public:
 
     InternalClassPool *classPool;
     InternalClass *emptyClass;
+    MegamorphicLookupCache *megamorphicLookupCache;
 
     InternalClass *arrayClass;
     InternalClass *stringClass;
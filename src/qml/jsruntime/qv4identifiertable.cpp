@@ -135,6 +135,27 @@ Heap::String *IdentifierTable::insertString(const QString &s)
     return str;
 }
 
+// Used when linking compilation units, where the hash is stored alongside the characters.
+// Only strings that are not interned yet are copied out of the unit's string table.
+Heap::String *IdentifierTable::insertString(const QChar *characters, int length, uint hash, uint subtype)
+{
+    uint idx = hash % alloc;
+    while (Heap::String *e = entries[idx]) {
+        if (e->stringHash == hash) {
+            const QString existing = e->toQString();
+            if (existing.length() == length && !memcmp(existing.constData(), characters, length * sizeof(QChar)))
+                return e;
+        }
+        ++idx;
+        idx %= alloc;
+    }
+
+    Heap::String *str = engine->newString(QString(characters, length));
+    str->stringHash = hash;
+    str->subtype = subtype;
+    addEntry(str);
+    return str;
+}
 
 Identifier *IdentifierTable::identifierImpl(const Heap::String *str)
 {
@@ -76,6 +76,7 @@ public:
     ~IdentifierTable();
 
     Heap::String *insertString(const QString &s);
+    Heap::String *insertString(const QChar *characters, int length, uint hash, uint subtype);
 
     Identifier *identifier(const Heap::String *str) {
         if (str->identifier)
@@ -335,8 +335,8 @@ ReturnedValue Lookup::getterTwoClasses(Lookup *l, ExecutionEngine *engine, const
         }
     }
 
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    l->getter = getterMegamorphic;
+    return getterMegamorphic(l, engine, object);
 }
 
 ReturnedValue Lookup::getterFallback(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -349,6 +349,45 @@ ReturnedValue Lookup::getterFallback(Lookup *l, ExecutionEngine *engine, const V
     return o->get(name);
 }
 
+ReturnedValue Lookup::getterMegamorphic(Lookup *l, ExecutionEngine *engine, const Value &object)
+{
+    const Object *obj = object.as<Object>();
+    // objects with their own get() may not have all of their properties in the internal class
+    if (!obj || obj->vtable()->get != Object::get)
+        return getterFallback(l, engine, object);
+
+    Heap::Object *o = obj->d();
+    Identifier *name = engine->current->compilationUnit->runtimeStrings[l->nameIndex]->identifier;
+    MegamorphicLookupCache::Entry *e = engine->megamorphicLookupCache->entry(o->internalClass, name);
+    if (e->internalClass == o->internalClass && e->name == name) {
+        if (!e->prototypeClass)
+            return o->propertyData(e->index)->asReturnedValue();
+        Heap::Object *p = o->prototype;
+        if (p && p->internalClass == e->prototypeClass
+                && reinterpret_cast<const ObjectVTable *>(p->vtable())->get == Object::get)
+            return p->propertyData(e->index)->asReturnedValue();
+    }
+
+    // Only data properties on the object or its prototype are cached, anything else is
+    // left to the generic code.
+    uint index = o->internalClass->find(name);
+    if (index != UINT_MAX) {
+        if (o->internalClass->propertyData.at(index).isData()) {
+            *e = { o->internalClass, name, nullptr, index };
+            return o->propertyData(index)->asReturnedValue();
+        }
+    } else if (Heap::Object *p = o->prototype) {
+        if (reinterpret_cast<const ObjectVTable *>(p->vtable())->get == Object::get) {
+            index = p->internalClass->find(name);
+            if (index != UINT_MAX && p->internalClass->propertyData.at(index).isData()) {
+                *e = { o->internalClass, name, p->internalClass, index };
+                return p->propertyData(index)->asReturnedValue();
+            }
+        }
+    }
+    return getterFallback(l, engine, object);
+}
+
 ReturnedValue Lookup::getter0(Lookup *l, ExecutionEngine *engine, const Value &object)
 {
     // we can safely cast to a QV4::Object here. If object is actually a string,
@@ -388,8 +427,8 @@ ReturnedValue Lookup::getter2(Lookup *l, ExecutionEngine *engine, const Value &o
             }
         }
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    l->getter = getterMegamorphic;
+    return getterMegamorphic(l, engine, object);
 }
 
 ReturnedValue Lookup::getter0getter0(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -403,8 +442,8 @@ ReturnedValue Lookup::getter0getter0(Lookup *l, ExecutionEngine *engine, const V
         if (l->classList[2] == o->internalClass)
             return o->propertyData(l->index2)->asReturnedValue();
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    l->getter = getterMegamorphic;
+    return getterMegamorphic(l, engine, object);
 }
 
 ReturnedValue Lookup::getter0getter1(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -418,8 +457,8 @@ ReturnedValue Lookup::getter0getter1(Lookup *l, ExecutionEngine *engine, const V
         if (l->classList[2] == o->internalClass && l->classList[3] == o->prototype->internalClass)
             return o->prototype->propertyData(l->index2)->asReturnedValue();
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    l->getter = getterMegamorphic;
+    return getterMegamorphic(l, engine, object);
 }
 
 ReturnedValue Lookup::getter1getter1(Lookup *l, ExecutionEngine *engine, const Value &object)
@@ -434,10 +473,9 @@ ReturnedValue Lookup::getter1getter1(Lookup *l, ExecutionEngine *engine, const V
         if (l->classList[2] == o->internalClass &&
             l->classList[3] == o->prototype->internalClass)
             return o->prototype->propertyData(l->index2)->asReturnedValue();
-        return getterFallback(l, engine, object);
     }
-    l->getter = getterFallback;
-    return getterFallback(l, engine, object);
+    l->getter = getterMegamorphic;
+    return getterMegamorphic(l, engine, object);
 }
 
 
@@ -100,6 +100,7 @@ struct Lookup {
     static ReturnedValue getterGeneric(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterTwoClasses(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getterFallback(Lookup *l, ExecutionEngine *engine, const Value &object);
+    static ReturnedValue getterMegamorphic(Lookup *l, ExecutionEngine *engine, const Value &object);
 
     static ReturnedValue getter0(Lookup *l, ExecutionEngine *engine, const Value &object);
     static ReturnedValue getter1(Lookup *l, ExecutionEngine *engine, const Value &object);
@@ -140,6 +141,31 @@ struct Lookup {
 
 };
 
+// Property reads of lookups that have seen more internal classes than they can cache
+// themselves go through this engine wide cache, keyed by internal class and name.
+// Internal classes and identifiers live as long as the engine, so entries never dangle.
+struct MegamorphicLookupCache {
+    enum { Size = 1024 }; // needs to be a power of two
+
+    struct Entry {
+        InternalClass *internalClass;
+        Identifier *name;
+        InternalClass *prototypeClass; // null if the property is on the object itself
+        uint index;
+    };
+
+    MegamorphicLookupCache() : entries() {}
+
+    Entry *entry(const InternalClass *internalClass, const Identifier *name)
+    {
+        quintptr hash = (quintptr(internalClass) >> 4) ^ (quintptr(name) >> 3);
+        hash ^= hash >> 10;
+        return entries + (hash & (Size - 1));
+    }
+
+    Entry entries[Size];
+};
+
 Q_STATIC_ASSERT(std::is_standard_layout<Lookup>::value);
 // Ensure that these offsets are always at this point to keep generated code compatible
 // across 32-bit and 64-bit (matters when cross-compiling).
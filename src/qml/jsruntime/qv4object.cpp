@@ -1146,7 +1146,7 @@ void Object::copyArrayData(Object *other)
             dd->values.size = other->d()->arrayData->values.size;
             dd->offset = other->d()->arrayData->offset;
         }
-        // ### need a write barrier
+        // no write barrier required, realloc() just allocated the array data
         memcpy(d()->arrayData->values.values, other->d()->arrayData->values.values, other->d()->arrayData->values.alloc*sizeof(Value));
     }
     setArrayLengthUnchecked(other->getLength());
@@ -126,7 +126,13 @@ struct ForEachIteratorObject: Object {
     V4_OBJECT2(ForEachIteratorObject, Object)
     Q_MANAGED_TYPE(ForeachIteratorObject)
 
-    ReturnedValue nextPropertyName() { return d()->it().nextPropertyNameAsString(); }
+    ReturnedValue nextPropertyName() {
+        Scope scope(engine());
+        ScopedValue name(scope, d()->it().nextPropertyNameAsString());
+        // the iterator stores into workArea through plain pointers
+        WriteBarrier::markWritten(scope.engine, d());
+        return name->asReturnedValue();
+    }
 
 protected:
     static void markObjects(Heap::Base *that, MarkStack *markStack);
@@ -61,6 +61,7 @@
 
 #define Q_V4_PROFILE_ALLOC(engine, size, type) (!engine)
 #define Q_V4_PROFILE_DEALLOC(engine, size, type) (!engine)
+#define Q_V4_PROFILE_GC(engine, statistics) (!engine)
 #define Q_V4_PROFILE(engine, function) (function->code(engine, function->codeData))
 
 QT_BEGIN_NAMESPACE
@@ -85,6 +86,11 @@ QT_END_NAMESPACE
             (engine->profiler()->featuresEnabled & (1 << Profiling::FeatureMemoryAllocation)) ?\
         engine->profiler()->trackDealloc(size, type) : false)
 
+#define Q_V4_PROFILE_GC(engine, statistics) \
+    (engine->profiler() &&\
+            (engine->profiler()->featuresEnabled & (1 << Profiling::FeatureGarbageCollection)) ?\
+        engine->profiler()->trackGarbageCollection(statistics) : false)
+
 #define Q_V4_PROFILE(engine, function)\
     (Q_UNLIKELY(engine->profiler()) &&\
             (engine->profiler()->featuresEnabled & (1 << Profiling::FeatureFunctionCall)) ?\
@@ -99,7 +105,8 @@ namespace Profiling {
 
 enum Features {
     FeatureFunctionCall,
-    FeatureMemoryAllocation
+    FeatureMemoryAllocation,
+    FeatureGarbageCollection
 };
 
 enum MemoryType {
@@ -139,6 +146,12 @@ struct MemoryAllocationProperties {
     MemoryType type;
 };
 
+struct GarbageCollectionProperties {
+    qint64 start;
+    qint64 end;
+    GCStatistics statistics;
+};
+
 class FunctionCall {
 public:
 
@@ -242,6 +255,16 @@ public:
         return true;
     }
 
+    bool trackGarbageCollection(const GCStatistics &statistics)
+    {
+        const qint64 end = m_timer.nsecsElapsed();
+        GarbageCollectionProperties collection = {
+            end - (statistics.markTime + statistics.sweepTime) * 1000, end, statistics
+        };
+        m_gc_data.append(collection);
+        return true;
+    }
+
     quint64 featuresEnabled;
 
     void stopProfiling();
@@ -252,13 +275,15 @@ public:
 signals:
     void dataReady(const QV4::Profiling::FunctionLocationHash &,
                    const QVector<QV4::Profiling::FunctionCallProperties> &,
-                   const QVector<QV4::Profiling::MemoryAllocationProperties> &);
+                   const QVector<QV4::Profiling::MemoryAllocationProperties> &,
+                   const QVector<QV4::Profiling::GarbageCollectionProperties> &);
 
 private:
     QV4::ExecutionEngine *m_engine;
     QElapsedTimer m_timer;
     QVector<FunctionCall> m_data;
     QVector<MemoryAllocationProperties> m_memory_data;
+    QVector<GarbageCollectionProperties> m_gc_data;
     QHash<quintptr, SentMarker> m_sentLocations;
 
     friend class FunctionCallProfiler;
@@ -295,6 +320,7 @@ public:
 } // namespace QV4
 
 Q_DECLARE_TYPEINFO(QV4::Profiling::MemoryAllocationProperties, Q_MOVABLE_TYPE);
+Q_DECLARE_TYPEINFO(QV4::Profiling::GarbageCollectionProperties, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(QV4::Profiling::FunctionCallProperties, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(QV4::Profiling::FunctionCall, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(QV4::Profiling::FunctionLocation, Q_MOVABLE_TYPE);
@@ -304,6 +330,7 @@ QT_END_NAMESPACE
 Q_DECLARE_METATYPE(QV4::Profiling::FunctionLocationHash)
 Q_DECLARE_METATYPE(QVector<QV4::Profiling::FunctionCallProperties>)
 Q_DECLARE_METATYPE(QVector<QV4::Profiling::MemoryAllocationProperties>)
+Q_DECLARE_METATYPE(QVector<QV4::Profiling::GarbageCollectionProperties>)
 
 #endif // QT_NO_QML_DEBUGGER
 
@@ -308,7 +308,7 @@ void RuntimeHelpers::numberToString(QString *result, double num, int radix)
 
 ReturnedValue Runtime::method_closure(ExecutionEngine *engine, int functionId)
 {
-    QV4::Function *clos = static_cast<CompiledData::CompilationUnit*>(engine->current->compilationUnit)->runtimeFunctions[functionId];
+    QV4::Function *clos = static_cast<CompiledData::CompilationUnit*>(engine->current->compilationUnit)->runtimeFunction(functionId);
     Q_ASSERT(clos);
     return FunctionObject::createScriptFunction(engine->currentContext, clos)->asReturnedValue();
 }
@@ -1314,15 +1314,20 @@ ReturnedValue Runtime::method_objectLiteral(ExecutionEngine *engine, const QV4::
     QV4::InternalClass *klass = static_cast<CompiledData::CompilationUnit*>(engine->current->compilationUnit)->runtimeClasses[classId];
     ScopedObject o(scope, engine->newObject(klass, engine->objectPrototype()));
 
+    // The internal class already has all the members, so this is a plain copy into the
+    // member data of the new object. Nothing may allocate before, as a collection could
+    // make the object black.
+    if (klass->size) {
+        o->d()->memberData->values.initialize(0, args, klass->size);
+        args += klass->size;
+    }
+
     {
         bool needSparseArray = arrayGetterSetterCountAndFlags >> 30;
         if (needSparseArray)
             o->initSparseArray();
     }
 
-    for (uint i = 0; i < klass->size; ++i)
-        o->setProperty(i, *args++);
-
     if (arrayValueCount > 0) {
         ScopedValue entry(scope);
         for (int i = 0; i < arrayValueCount; ++i) {
@@ -357,6 +357,11 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
     {
         void *ptr = popPtr(data);
         QQmlListModelWorkerAgent *agent = (QQmlListModelWorkerAgent *)ptr;
+        if (!agent->setEngine(engine)) {
+            qWarning("WorkerScript: A ListModel can only be shared by worker scripts that run on the same thread");
+            agent->release();
+            return QV4::Encode::undefined();
+        }
         QV4::ScopedValue rv(scope, QV4::QObjectWrapper::wrap(engine, agent));
         // ### Find a better solution then the ugly property
         QQmlListModelWorkerAgent::VariantRef ref(agent);
@@ -366,7 +371,6 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         rv->as<Object>()->defineReadonlyProperty(s, v);
 
         agent->release();
-        agent->setEngine(engine);
         return rv->asReturnedValue();
     }
     case WorkerSequence:
@@ -354,6 +354,17 @@ Param traceParam(const Param &param)
     } \
 }
 
+// For instructions that can't throw. The result can still live in a call context on the heap.
+#define MOVEVALUE(param, value) { \
+    QV4::Value tmp; \
+    tmp = (value); \
+    if (Q_LIKELY(!engine->writeBarrierActive || !scopes[param.scope].base)) { \
+        VALUE(param) = tmp; \
+    } else { \
+        QV4::WriteBarrier::write(engine, scopes[param.scope].base, VALUEPTR(param), tmp); \
+    } \
+}
+
 // qv4scopedvalue_p.h also defines a CHECK_EXCEPTION macro
 #ifdef CHECK_EXCEPTION
 #undef CHECK_EXCEPTION
@@ -448,25 +459,27 @@ QV4::ReturnedValue VME::run(ExecutionEngine *engine, const uchar *code
 #endif
 
     MOTH_BEGIN_INSTR(Move)
-        VALUE(instr.result) = VALUE(instr.source);
+        MOVEVALUE(instr.result, VALUE(instr.source));
     MOTH_END_INSTR(Move)
 
     MOTH_BEGIN_INSTR(MoveConst)
-        VALUE(instr.result) = instr.source;
+        MOVEVALUE(instr.result, instr.source);
     MOTH_END_INSTR(MoveConst)
 
     MOTH_BEGIN_INSTR(SwapTemps)
-        qSwap(VALUE(instr.left),  VALUE(instr.right));
+        QV4::Value left = VALUE(instr.left);
+        MOVEVALUE(instr.left, VALUE(instr.right));
+        MOVEVALUE(instr.right, left);
     MOTH_END_INSTR(MoveTemp)
 
     MOTH_BEGIN_INSTR(LoadRuntimeString)
 //        TRACE(value, "%s", instr.value.toString(context)->toQString().toUtf8().constData());
-        VALUE(instr.result) = context->d()->compilationUnit->runtimeStrings[instr.stringId];
+        MOVEVALUE(instr.result, context->d()->compilationUnit->runtimeStrings[instr.stringId]);
     MOTH_END_INSTR(LoadRuntimeString)
 
     MOTH_BEGIN_INSTR(LoadRegExp)
 //        TRACE(value, "%s", instr.value.toString(context)->toQString().toUtf8().constData());
-        VALUE(instr.result) = static_cast<CompiledData::CompilationUnit*>(context->d()->compilationUnit)->runtimeRegularExpressions[instr.regExpId];
+        MOVEVALUE(instr.result, static_cast<CompiledData::CompilationUnit*>(context->d()->compilationUnit)->runtimeRegularExpressions[instr.regExpId]);
     MOTH_END_INSTR(LoadRegExp)
 
     MOTH_BEGIN_INSTR(LoadClosure)
@@ -941,19 +954,19 @@ QV4::ReturnedValue VME::run(ExecutionEngine *engine, const uchar *code
 #endif // QT_NO_QML_DEBUGGER
 
     MOTH_BEGIN_INSTR(LoadThis)
-        VALUE(instr.result) = context->thisObject();
+        MOVEVALUE(instr.result, context->thisObject());
     MOTH_END_INSTR(LoadThis)
 
     MOTH_BEGIN_INSTR(LoadQmlContext)
-        VALUE(instr.result) = Runtime::method_getQmlContext(static_cast<QV4::NoThrowEngine*>(engine));
+        MOVEVALUE(instr.result, Runtime::method_getQmlContext(static_cast<QV4::NoThrowEngine*>(engine)));
     MOTH_END_INSTR(LoadQmlContext)
 
     MOTH_BEGIN_INSTR(LoadQmlImportedScripts)
-        VALUE(instr.result) = Runtime::method_getQmlImportedScripts(static_cast<QV4::NoThrowEngine*>(engine));
+        MOVEVALUE(instr.result, Runtime::method_getQmlImportedScripts(static_cast<QV4::NoThrowEngine*>(engine)));
     MOTH_END_INSTR(LoadQmlImportedScripts)
 
     MOTH_BEGIN_INSTR(LoadQmlSingleton)
-        VALUE(instr.result) = Runtime::method_getQmlSingleton(static_cast<QV4::NoThrowEngine*>(engine), instr.name);
+        MOVEVALUE(instr.result, Runtime::method_getQmlSingleton(static_cast<QV4::NoThrowEngine*>(engine), instr.name));
     MOTH_END_INSTR(LoadQmlSingleton)
 
 #ifdef MOTH_THREADED_INTERPRETER
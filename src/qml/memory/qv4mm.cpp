@@ -52,6 +52,7 @@
 
 #include <QElapsedTimer>
 #include <QMap>
+#include <QScopedPointer>
 #include <QScopedValueRollback>
 
 #include <iostream>
@@ -99,7 +100,8 @@ namespace QV4 {
 
 enum {
     MinSlotsGCLimit = QV4::Chunk::AvailableSlots*16,
-    GCOverallocation = 200 /* Max overallocation by the GC in % */
+    GCOverallocation = 200, /* Max overallocation by the GC in % */
+    DefaultIncrementalGCStepBudget = 1000 /* in us */
 };
 
 struct MemorySegment {
@@ -394,7 +396,9 @@ void Chunk::sweep(ClassDestroyStatsCallback classCountPtr)
             }
         }
         objectBitmap[i] = blackBitmap[i];
-        grayBitmap[i] = 0;
+        // survivors keep their gray bit, with lazy sweeping the barrier may have set it
+        // after the collection
+        grayBitmap[i] &= blackBitmap[i];
         extendsBitmap[i] = e;
         lastSlotFree = !((objectBitmap[i]|extendsBitmap[i]) >> (sizeof(quintptr)*8 - 1));
         SDUMP() << "        new extends =" << binary(e);
@@ -405,6 +409,34 @@ void Chunk::sweep(ClassDestroyStatsCallback classCountPtr)
     //    DEBUG << "swept chunk" << this << "freed" << slotsFreed << "slots.";
 }
 
+uint Chunk::nLiveSlots() const
+{
+    // same as sweep(), without destroying anything
+    uint liveSlots = 0;
+    bool lastSlotFree = false;
+    for (uint i = 0; i < Chunk::EntriesInBitmap; ++i) {
+        quintptr toFree = objectBitmap[i] ^ blackBitmap[i];
+        quintptr e = extendsBitmap[i];
+        if (lastSlotFree)
+            e &= (e + 1); // clear all lowest extent bits
+        while (toFree) {
+            uint index = qCountTrailingZeroBits(toFree);
+            quintptr bit = (static_cast<quintptr>(1) << index);
+            toFree ^= bit;
+
+            // remove the extends slots of the object
+            quintptr mask = (bit << 1) - 1;
+            quintptr result = (e | mask) + 1;
+            result |= mask;
+            e &= result;
+        }
+        const quintptr used = blackBitmap[i] | e;
+        liveSlots += qPopulationCount(used);
+        lastSlotFree = !(used >> (sizeof(quintptr)*8 - 1));
+    }
+    return liveSlots;
+}
+
 void Chunk::freeAll()
 {
     //    DEBUG << "sweeping chunk" << this << (*freeList);
@@ -479,6 +511,8 @@ void Chunk::collectGrayItems(MarkStack *markStack)
             ++nGrayItems;
 //            qDebug() << "adding gray item" << b << "to mark stack";
 #endif
+            if (markStack->top >= markStack->limit)
+                markStack->drain();
         }
         grayBitmap[i] = 0;
         o += Chunk::Bits;
@@ -606,6 +640,7 @@ HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
 
     HeapItem *m;
 
+retry:
     if (slotsRequired < NumBins - 1) {
         m = freeBins[slotsRequired];
         if (m) {
@@ -675,6 +710,9 @@ HeapItem *BlockAllocator::allocate(size_t size, bool forceAllocation) {
     }
 
     if (!m) {
+        // get more free slots from the chunks the last collection left unswept
+        if (sweepNextChunk())
+            goto retry;
         if (!forceAllocation)
             return 0;
         Chunk *newChunk = chunkAllocator->allocate();
@@ -692,22 +730,107 @@ done:
     return m;
 }
 
+void BlockAllocator::sweepChunk(Chunk *c, ClassDestroyStatsCallback classCountPtr)
+{
+    c->sweep(classCountPtr);
+    if (resetBlackBitsAfterSweep)
+        c->resetBlackBits();
+}
+
+// Objects never move, so the best we can do against fragmentation is to hand out the free
+// slots of the fullest chunks first. Sparse chunks then get a chance to run empty, and
+// empty chunks beyond the overallocation limit are given back to the OS.
+bool BlockAllocator::shouldReleaseEmptyChunk() const
+{
+    const size_t slotsToKeep = qMax(static_cast<size_t>(MinSlotsGCLimit), usedSlotsAfterLastSweep * GCOverallocation / 100);
+    return totalSlots() >= slotsToKeep + Chunk::AvailableSlots;
+}
+
+void BlockAllocator::releaseChunk(Chunk *c)
+{
+    chunks.erase(std::find(chunks.begin(), chunks.end(), c));
+    chunkAllocator->free(c);
+    ++releasedChunks;
+}
+
 void BlockAllocator::sweep(ClassDestroyStatsCallback classCountPtr)
 {
     nextFree = 0;
     nFree = 0;
     memset(freeBins, 0, sizeof(freeBins));
+    chunksToSweep.clear();
 
 //    qDebug() << "BlockAlloc: sweep";
     usedSlotsAfterLastSweep = 0;
+    std::vector<std::pair<uint, Chunk *>> usage;
+    usage.reserve(chunks.size());
     for (auto c : chunks) {
-        c->sweep(classCountPtr);
-        c->sortIntoBins(freeBins, NumBins);
+        sweepChunk(c, classCountPtr);
 //        qDebug() << "used slots in chunk" << c << ":" << c->nUsedSlots();
-        usedSlotsAfterLastSweep += c->nUsedSlots();
+        const uint used = c->nUsedSlots();
+        usedSlotsAfterLastSweep += used;
+        usage.push_back(std::make_pair(used, c));
+    }
+
+    // sortIntoBins() prepends, so the fullest chunks have to come last
+    std::sort(usage.begin(), usage.end());
+    for (const auto &u : usage) {
+        if (!u.first && shouldReleaseEmptyChunk())
+            releaseChunk(u.second);
+        else
+            u.second->sortIntoBins(freeBins, NumBins);
     }
 }
 
+void BlockAllocator::startLazySweep()
+{
+    Q_ASSERT(chunksToSweep.empty());
+    nextFree = 0;
+    nFree = 0;
+    memset(freeBins, 0, sizeof(freeBins));
+
+    // count what the chunks will hold once they are swept, like sweep() does
+    usedSlotsAfterLastSweep = 0;
+    for (auto c : chunks)
+        usedSlotsAfterLastSweep += c->nLiveSlots();
+    chunksToSweep = chunks;
+
+    // sweep the chunks with the most live objects first, so that they get filled up first
+    std::vector<std::pair<uint, Chunk *>> live;
+    live.reserve(chunks.size());
+    for (auto c : chunks)
+        live.push_back(std::make_pair(c->nMarkedObjects(), c));
+    std::sort(live.begin(), live.end());
+    for (size_t i = 0; i < live.size(); ++i)
+        chunksToSweep[i] = live.at(i).second;
+}
+
+bool BlockAllocator::sweepNextChunk()
+{
+    if (chunksToSweep.empty() || sweepingChunk)
+        return false;
+
+    Chunk *c = chunksToSweep.back();
+    chunksToSweep.pop_back();
+    {
+        QScopedValueRollback<bool> sweeping(sweepingChunk, true);
+        sweepChunk(c, nullptr);
+    }
+    // already accounted for by startLazySweep()
+    const uint usedAfter = c->nUsedSlots();
+    if (!usedAfter && shouldReleaseEmptyChunk())
+        releaseChunk(c);
+    else
+        c->sortIntoBins(freeBins, NumBins);
+    return true;
+}
+
+void BlockAllocator::finishSweep()
+{
+    while (sweepNextChunk())
+        ;
+}
+
 void BlockAllocator::freeAll()
 {
     for (auto c : chunks) {
@@ -788,6 +911,8 @@ void HugeItemAllocator::sweep(ClassDestroyStatsCallback classCountPtr)
         bool b = c.chunk->first()->isBlack();
         if (!b)
             freeHugeChunk(chunkAllocator, c, classCountPtr);
+        else
+            Chunk::clearBit(c.chunk->grayBitmap, c.chunk->first() - c.chunk->realBase());
         return !b;
     };
 
@@ -803,14 +928,20 @@ void HugeItemAllocator::resetBlackBits()
 
 void HugeItemAllocator::collectGrayItems(MarkStack *markStack)
 {
-    for (auto c : chunks)
-        // Correct for a Steele type barrier
-        if (Chunk::testBit(c.chunk->blackBitmap, c.chunk->first() - c.chunk->realBase()) &&
-            Chunk::testBit(c.chunk->grayBitmap, c.chunk->first() - c.chunk->realBase())) {
+    for (auto c : chunks) {
+        const size_t index = c.chunk->first() - c.chunk->realBase();
+        // Correct for a Steele type barrier. The item is black already, so push it directly
+        // instead of going through mark(), which would skip it.
+        if (Chunk::testBit(c.chunk->blackBitmap, index) &&
+            Chunk::testBit(c.chunk->grayBitmap, index)) {
             HeapItem *i = c.chunk->first();
             Heap::Base *b = *i;
-            b->mark(markStack);
+            markStack->push(b);
+            if (markStack->top >= markStack->limit)
+                markStack->drain();
         }
+        Chunk::clearBit(c.chunk->grayBitmap, index);
+    }
 }
 
 void HugeItemAllocator::freeAll()
@@ -832,7 +963,22 @@ MemoryManager::MemoryManager(ExecutionEngine *engine)
     , unmanagedHeapSizeGCLimit(MIN_UNMANAGED_HEAPSIZE_GC_LIMIT)
     , aggressiveGC(!qEnvironmentVariableIsEmpty("QV4_MM_AGGRESSIVE_GC"))
     , gcStats(!qEnvironmentVariableIsEmpty(QV4_MM_STATS))
+    , generationalGC(WriteBarrier::isRequired<WriteBarrier::Object>()
+                     && qEnvironmentVariableIsEmpty(QV4_MM_NO_GENERATIONAL_GC))
 {
+    // Incremental marking relies on the write barrier to catch stores into already
+    // marked objects.
+    if (WriteBarrier::isRequired<WriteBarrier::Object>() && !qEnvironmentVariableIsEmpty(QV4_MM_INCREMENTAL_GC)) {
+        bool ok = false;
+        const int budget = qEnvironmentVariableIntValue(QV4_MM_INCREMENTAL_GC, &ok);
+        incrementalGCStepBudget = (ok && budget > 0) ? budget : DefaultIncrementalGCStepBudget;
+    }
+
+    // The barrier records the remembered set for minor collections, so it has to be on
+    // all the time in generational mode.
+    engine->writeBarrierActive = generationalGC;
+    blockAllocator.resetBlackBitsAfterSweep = !generationalGC;
+    lazySweep = qEnvironmentVariableIsEmpty(QV4_MM_NO_LAZY_SWEEP);
 #ifdef V4_USE_VALGRIND
     VALGRIND_CREATE_MEMPOOL(this, 0, true);
 #endif
@@ -853,14 +999,15 @@ Heap::Base *MemoryManager::allocString(std::size_t unmanagedSize)
 
     bool didGCRun = false;
     if (aggressiveGC) {
-        runGC();
+        runGC(MajorCollection, GCStatistics::AggressiveTrigger);
         didGCRun = true;
     }
 
     unmanagedHeapSize += unmanagedSize;
     if (unmanagedHeapSize > unmanagedHeapSizeGCLimit) {
+        // this needs the destructors to run right away to see the effect on the unmanaged heap
         if (!didGCRun)
-            runGC();
+            runGC(MajorCollection, GCStatistics::UnmanagedHeapTrigger);
 
         if (3*unmanagedHeapSizeGCLimit <= 4*unmanagedHeapSize)
             // more than 75% full, raise limit
@@ -874,7 +1021,7 @@ Heap::Base *MemoryManager::allocString(std::size_t unmanagedSize)
     HeapItem *m = blockAllocator.allocate(stringSize);
     if (!m) {
         if (!didGCRun && shouldRunGC())
-            runGC();
+            collectForAllocation();
         m = blockAllocator.allocate(stringSize, true);
     }
 
@@ -892,7 +1039,7 @@ Heap::Base *MemoryManager::allocData(std::size_t size)
 
     bool didRunGC = false;
     if (aggressiveGC) {
-        runGC();
+        runGC(MajorCollection, GCStatistics::AggressiveTrigger);
         didRunGC = true;
     }
 #ifdef DETAILED_MM_STATS
@@ -913,7 +1060,7 @@ Heap::Base *MemoryManager::allocData(std::size_t size)
     HeapItem *m = blockAllocator.allocate(size);
     if (!m) {
         if (!didRunGC && shouldRunGC())
-            runGC();
+            collectForAllocation();
         m = blockAllocator.allocate(size, true);
     }
 
@@ -977,6 +1124,24 @@ void MarkStack::drain()
     }
 }
 
+bool MarkStack::drain(qint64 nsecs)
+{
+    QElapsedTimer t;
+    t.start();
+    while (top > base) {
+        // don't query the clock for every single object
+        for (int i = 0; i < 64 && top > base; ++i) {
+            Heap::Base *h = pop();
+            ++markStackSize;
+            Q_ASSERT(h);
+            h->markChildren(this);
+        }
+        if (t.nsecsElapsed() >= nsecs)
+            return top == base;
+    }
+    return true;
+}
+
 void MemoryManager::collectRoots(MarkStack *markStack)
 {
     engine->markObjects(markStack);
@@ -1022,17 +1187,100 @@ void MemoryManager::collectRoots(MarkStack *markStack)
     }
 }
 
-void MemoryManager::mark()
+void MemoryManager::collectRootsAndRememberedSet(MarkStack *markStack, CollectionType type)
+{
+    collectRoots(markStack);
+
+    if (type == MinorCollection) {
+        // Objects that survived the last collection still have their black bit set, so
+        // marking stops at them. The ones written to since then got their gray bit set by
+        // the write barrier and form the remembered set: rescan their children.
+        blockAllocator.collectGrayItems(markStack);
+        hugeItemAllocator.collectGrayItems(markStack);
+    }
+}
+
+void MemoryManager::mark(CollectionType type)
 {
+    if (incrementalMarkStack) {
+        // Final pause of an incremental collection. The mutator ran between the mark steps,
+        // so rescan the roots and the marked objects the write barrier grayed meanwhile.
+        QScopedPointer<MarkStack> markStack(incrementalMarkStack);
+        incrementalMarkStack = nullptr;
+        collectRoots(markStack.data());
+        blockAllocator.collectGrayItems(markStack.data());
+        hugeItemAllocator.collectGrayItems(markStack.data());
+        markStack->drain();
+        engine->writeBarrierActive = generationalGC;
+        return;
+    }
+
     markStackSize = 0;
 
     MarkStack markStack(engine);
-    collectRoots(&markStack);
+    collectRootsAndRememberedSet(&markStack, type);
 
     markStack.drain();
 }
 
-void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPtr)
+void MemoryManager::startIncrementalGC(CollectionType type, GCStatistics::Trigger trigger)
+{
+    Q_ASSERT(!incrementalMarkStack);
+    QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+
+    type = prepareCollection(type);
+    markStackSize = 0;
+    incrementalMarkStack = new MarkStack(engine);
+    incrementalCollectionType = type;
+    incrementalCollectionTrigger = trigger;
+    totalSlotsAtIncrementalGCStart = blockAllocator.totalSlots();
+    engine->writeBarrierActive = true;
+
+    collectRootsAndRememberedSet(incrementalMarkStack, type);
+}
+
+bool MemoryManager::runIncrementalGCStep(qint64 usecs)
+{
+    if (!incrementalMarkStack || isGCBlocked())
+        return false;
+
+    if (usecs < 0)
+        usecs = incrementalGCStepBudget;
+
+    bool done;
+    {
+        QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
+        done = incrementalMarkStack->drain(usecs * 1000);
+    }
+    if (done)
+        runGC(incrementalCollectionType, incrementalCollectionTrigger);
+    return true;
+}
+
+void MemoryManager::collectForAllocation()
+{
+    if (isGCBlocked())
+        return;
+
+    if (!isIncrementalGCEnabled()) {
+        runGC(MinorCollection, GCStatistics::AllocationTrigger);
+        return;
+    }
+
+    if (!incrementalMarkStack) {
+        startIncrementalGC(MinorCollection, GCStatistics::AllocationTrigger);
+        return;
+    }
+
+    // Marking doesn't keep up with the allocations, finish the collection in one go
+    // instead of letting the heap grow without bounds.
+    if (blockAllocator.totalSlots() * 100 > totalSlotsAtIncrementalGCStart * GCOverallocation)
+        runGC(incrementalCollectionType, incrementalCollectionTrigger);
+    else
+        runIncrementalGCStep();
+}
+
+void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPtr, bool lazily)
 {
     for (PersistentValueStorage::Iterator it = m_weakValues->begin(); it != m_weakValues->end(); ++it) {
         Managed *m = (*it).managed();
@@ -1079,18 +1327,50 @@ void MemoryManager::sweep(bool lastSweep, ClassDestroyStatsCallback classCountPt
         }
     }
 
-    blockAllocator.sweep(classCountPtr);
+    if (lazily)
+        blockAllocator.startLazySweep();
+    else
+        blockAllocator.sweep(classCountPtr);
     hugeItemAllocator.sweep(classCountPtr);
 }
 
 bool MemoryManager::shouldRunGC() const
 {
     size_t total = blockAllocator.totalSlots();
-    if (total > MinSlotsGCLimit && usedSlotsAfterLastFullSweep * GCOverallocation < total * 100)
+    if (total > MinSlotsGCLimit && blockAllocator.usedSlotsAfterLastSweep * GCOverallocation < total * 100)
         return true;
     return false;
 }
 
+MemoryManager::CollectionType MemoryManager::prepareCollection(CollectionType type)
+{
+    // marking needs the bitmaps of all chunks to be up to date
+    if (blockAllocator.hasChunksToSweep())
+        blockAllocator.finishSweep();
+
+    if (type == MinorCollection && !canRunMinorCollection())
+        type = MajorCollection;
+
+    if (type == MajorCollection && generationalGC) {
+        // survivors of earlier collections keep their black bits in generational mode
+        blockAllocator.resetBlackBits();
+        hugeItemAllocator.resetBlackBits();
+    }
+    return type;
+}
+
+bool MemoryManager::canRunMinorCollection() const
+{
+    if (!generationalGC)
+        return false;
+    // Unmanaged memory is mostly held by old strings and array buffers
+    if (unmanagedHeapSize > unmanagedHeapSizeGCLimit)
+        return false;
+    // Minor collections never free old objects, so do a major one once the heap has
+    // grown past the overallocation limit relative to the last major collection.
+    return blockAllocator.usedSlotsAfterLastSweep * 100 <= usedSlotsAfterLastMajorCollection * GCOverallocation;
+}
+
 size_t dumpBins(BlockAllocator *b, bool printOutput = true)
 {
     size_t totalSlotMem = 0;
@@ -1119,9 +1399,9 @@ size_t dumpBins(BlockAllocator *b, bool printOutput = true)
     return totalSlotMem*Chunk::SlotSize;
 }
 
-void MemoryManager::runGC()
+void MemoryManager::runGC(CollectionType type, GCStatistics::Trigger trigger)
 {
-    if (gcBlocked) {
+    if (isGCBlocked()) {
 //        qDebug() << "Not running GC.";
         return;
     }
@@ -1129,26 +1409,55 @@ void MemoryManager::runGC()
     QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
 //    qDebug() << "runGC";
 
+    // Collections triggered by allocations leave the sweeping of the chunks to the
+    // allocator. Explicit ones free everything right away.
+    const bool sweepLazily = lazySweep && trigger == GCStatistics::AllocationTrigger && !aggressiveGC;
+
+    if (incrementalMarkStack && type == MajorCollection && incrementalCollectionType == MinorCollection) {
+        // A major collection starts over with all black bits cleared, so the marking
+        // done by the running minor collection is of no use.
+        delete incrementalMarkStack;
+        incrementalMarkStack = nullptr;
+        engine->writeBarrierActive = generationalGC;
+    }
+
+    const bool incremental = incrementalMarkStack != nullptr;
+    if (incremental)
+        type = incrementalCollectionType;
+    else
+        type = prepareCollection(type);
+
+    GCStatistics stats;
+    stats.sequenceNumber = gcStatistics.sequenceNumber + 1;
+    stats.trigger = trigger;
+    stats.minorCollection = (type == MinorCollection);
+    stats.incremental = incremental;
+    stats.usedBefore = getUsedMem();
+    stats.largeItemsBefore = getLargeItemsMem();
+    stats.unmanagedHeapBefore = unmanagedHeapSize;
+    const size_t releasedChunksBefore = blockAllocator.releasedChunks;
+
     if (!gcStats) {
-//        uint oldUsed = allocator.usedMem();
-        mark();
-        sweep();
-//        DEBUG << "RUN GC: allocated:" << allocator.allocatedMem() << "used before" << oldUsed << "used now" << allocator.usedMem();
+        QElapsedTimer t;
+        t.start();
+        mark(type);
+        stats.markTime = t.nsecsElapsed()/1000;
+        t.restart();
+        sweep(/*lastSweep*/false, nullptr, sweepLazily);
+        stats.sweepTime = t.nsecsElapsed()/1000;
     } else {
-        bool triggeredByUnmanagedHeap = (unmanagedHeapSize > unmanagedHeapSizeGCLimit);
-        size_t oldUnmanagedSize = unmanagedHeapSize;
+        bool triggeredByUnmanagedHeap = (trigger == GCStatistics::UnmanagedHeapTrigger);
         const size_t totalMem = getAllocatedMem();
-        const size_t usedBefore = getUsedMem();
-        const size_t largeItemsBefore = getLargeItemsMem();
 
         qDebug() << "========== GC ==========";
+        qDebug() << "    Collection type:" << (type == MinorCollection ? "minor" : "major");
 #ifdef MM_STATS
         qDebug() << "    Triggered by alloc request of" << lastAllocRequestedSlots << "slots.";
         qDebug() << "    Allocations since last GC" << allocationCount;
         allocationCount = 0;
 #endif
         qDebug() << "Allocated" << totalMem << "bytes in" << blockAllocator.chunks.size() << "chunks";
-        qDebug() << "Fragmented memory before GC" << (totalMem - usedBefore);
+        qDebug() << "Fragmented memory before GC" << (totalMem - stats.usedBefore);
         dumpBins(&blockAllocator);
 
 #ifdef MM_STATS
@@ -1157,24 +1466,24 @@ void MemoryManager::runGC()
 
         QElapsedTimer t;
         t.start();
-        mark();
-        qint64 markTime = t.nsecsElapsed()/1000;
+        mark(type);
+        stats.markTime = t.nsecsElapsed()/1000;
         t.restart();
         sweep(false, increaseFreedCountForClass);
         const size_t usedAfter = getUsedMem();
         const size_t largeItemsAfter = getLargeItemsMem();
-        qint64 sweepTime = t.nsecsElapsed()/1000;
+        stats.sweepTime = t.nsecsElapsed()/1000;
 
         if (triggeredByUnmanagedHeap) {
             qDebug() << "triggered by unmanaged heap:";
-            qDebug() << "   old unmanaged heap size:" << oldUnmanagedSize;
+            qDebug() << "   old unmanaged heap size:" << stats.unmanagedHeapBefore;
             qDebug() << "   new unmanaged heap:" << unmanagedHeapSize;
             qDebug() << "   unmanaged heap limit:" << unmanagedHeapSizeGCLimit;
         }
         size_t memInBins = dumpBins(&blockAllocator);
-        qDebug() << "Marked object in" << markTime << "us.";
+        qDebug() << "Marked object in" << stats.markTime << "us.";
         qDebug() << "   " << markStackSize << "objects marked";
-        qDebug() << "Sweeped object in" << sweepTime << "us.";
+        qDebug() << "Sweeped object in" << stats.sweepTime << "us.";
 
         // sort our object types by number of freed instances
         MMStatsHash freedObjectStats;
@@ -1189,16 +1498,17 @@ void MemoryManager::runGC()
             return a.second > b.second && strcmp(a.first, b.first) < 0;
         });
 
-        qDebug() << "Used memory before GC:" << usedBefore;
+        qDebug() << "Used memory before GC:" << stats.usedBefore;
         qDebug() << "Used memory after GC :" << usedAfter;
-        qDebug() << "Freed up bytes       :" << (usedBefore - usedAfter);
+        qDebug() << "Freed up bytes       :" << (stats.usedBefore - usedAfter);
+        qDebug() << "Released empty chunks:" << (blockAllocator.releasedChunks - releasedChunksBefore);
         size_t lost = blockAllocator.allocatedMem() - memInBins - usedAfter;
         if (lost)
             qDebug() << "!!!!!!!!!!!!!!!!!!!!! LOST MEM:" << lost << "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!";
-        if (largeItemsBefore || largeItemsAfter) {
-            qDebug() << "Large item memory before GC:" << largeItemsBefore;
+        if (stats.largeItemsBefore || largeItemsAfter) {
+            qDebug() << "Large item memory before GC:" << stats.largeItemsBefore;
             qDebug() << "Large item memory after GC:" << largeItemsAfter;
-            qDebug() << "Large item memory freed up:" << (largeItemsBefore - largeItemsAfter);
+            qDebug() << "Large item memory freed up:" << (stats.largeItemsBefore - largeItemsAfter);
         }
 
         for (auto it = freedObjectsSorted.cbegin(); it != freedObjectsSorted.cend(); ++it) {
@@ -1208,16 +1518,27 @@ void MemoryManager::runGC()
         qDebug() << "======== End GC ========";
     }
 
+    // not getUsedMem(), the chunks that are left to the lazy sweep still hold the garbage
+    stats.usedAfter = blockAllocator.usedSlotsAfterLastSweep * Chunk::SlotSize;
+    stats.largeItemsAfter = getLargeItemsMem();
+    stats.chunks = blockAllocator.chunks.size();
+    stats.releasedChunks = blockAllocator.releasedChunks - releasedChunksBefore;
+    stats.unmanagedHeapAfter = unmanagedHeapSize;
+    gcStatistics = stats;
+    Q_V4_PROFILE_GC(engine, stats);
+
     if (aggressiveGC) {
         // ensure we don't 'loose' any memory
         Q_ASSERT(blockAllocator.allocatedMem() == getUsedMem() + dumpBins(&blockAllocator, false));
     }
 
-    usedSlotsAfterLastFullSweep = blockAllocator.usedSlotsAfterLastSweep;
+    if (type == MajorCollection)
+        usedSlotsAfterLastMajorCollection = blockAllocator.usedSlotsAfterLastSweep;
 
-    // reset all black bits
-    blockAllocator.resetBlackBits();
-    hugeItemAllocator.resetBlackBits();
+    if (!generationalGC) {
+        // reset all black bits, the block allocator does so for each chunk it sweeps
+        hugeItemAllocator.resetBlackBits();
+    }
 }
 
 size_t MemoryManager::getUsedMem() const
@@ -1239,6 +1560,12 @@ MemoryManager::~MemoryManager()
 {
     delete m_persistentValues;
 
+    delete incrementalMarkStack;
+    incrementalMarkStack = nullptr;
+
+    // in generational mode the survivors of the last collection are still marked
+    blockAllocator.resetBlackBits();
+    hugeItemAllocator.resetBlackBits();
     sweep(/*lastSweep*/true);
     blockAllocator.freeAll();
     hugeItemAllocator.freeAll();
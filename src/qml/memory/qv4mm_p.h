@@ -63,6 +63,9 @@
 #define QV4_MM_MAXBLOCK_SHIFT "QV4_MM_MAXBLOCK_SHIFT"
 #define QV4_MM_MAX_CHUNK_SIZE "QV4_MM_MAX_CHUNK_SIZE"
 #define QV4_MM_STATS "QV4_MM_STATS"
+#define QV4_MM_NO_GENERATIONAL_GC "QV4_MM_NO_GENERATIONAL_GC"
+#define QV4_MM_INCREMENTAL_GC "QV4_MM_INCREMENTAL_GC"
+#define QV4_MM_NO_LAZY_SWEEP "QV4_MM_NO_LAZY_SWEEP"
 
 #define MM_DEBUG 0
 
@@ -154,6 +157,12 @@ struct BlockAllocator {
     }
 
     void sweep(ClassDestroyStatsCallback classCountPtr);
+    // Lazy sweeping: the collector only queues the chunks, and allocate() sweeps them one
+    // at a time when it runs out of free slots. Everything has to be swept before marking again.
+    void startLazySweep();
+    bool sweepNextChunk();
+    void finishSweep();
+    bool hasChunksToSweep() const { return !chunksToSweep.empty(); }
     void freeAll();
     void resetBlackBits();
     void collectGrayItems(MarkStack *markStack);
@@ -165,9 +174,18 @@ struct BlockAllocator {
     HeapItem *freeBins[NumBins];
     ChunkAllocator *chunkAllocator;
     std::vector<Chunk *> chunks;
+    std::vector<Chunk *> chunksToSweep;
+    bool resetBlackBitsAfterSweep = true;
+    bool sweepingChunk = false; // sweepNextChunk() is running destroy callbacks
+    size_t releasedChunks = 0;
 #if MM_DEBUG
     uint allocations[NumBins];
 #endif
+
+private:
+    void sweepChunk(Chunk *c, ClassDestroyStatsCallback classCountPtr);
+    bool shouldReleaseEmptyChunk() const;
+    void releaseChunk(Chunk *c);
 };
 
 struct HugeItemAllocator {
@@ -422,7 +440,25 @@ public:
         return t->d();
     }
 
-    void runGC();
+    enum CollectionType {
+        // Only traces from the roots and the objects written to since the last collection.
+        // Objects that survived an earlier collection are not freed.
+        MinorCollection,
+        MajorCollection
+    };
+
+    void runGC(CollectionType type = MajorCollection,
+               GCStatistics::Trigger trigger = GCStatistics::ExplicitTrigger);
+
+    // Incremental marking. Collections triggered by allocations only collect the roots and then
+    // mark in bounded steps, the mutator keeping the heap consistent through the write barrier.
+    // A final pause rescans the roots and the objects written to meanwhile before sweeping.
+    bool isIncrementalGCEnabled() const { return incrementalGCStepBudget > 0; }
+    bool isIncrementalGCRunning() const { return incrementalMarkStack != nullptr; }
+    // Marks for at most usecs microseconds (or the configured budget if negative) and
+    // finishes the collection once nothing is left to mark. Returns false if no
+    // incremental collection is running.
+    bool runIncrementalGCStep(qint64 usecs = -1);
 
     void dumpStats() const;
 
@@ -430,6 +466,8 @@ public:
     size_t getAllocatedMem() const;
     size_t getLargeItemsMem() const;
 
+    const GCStatistics &lastGCStatistics() const { return gcStatistics; }
+
     // called when a JS object grows itself. Specifically: Heap::String::append
     void changeUnmanagedHeapSizeUsage(qptrdiff delta) { unmanagedHeapSize += delta; }
 
@@ -445,9 +483,17 @@ protected:
 
 private:
     void collectFromJSStack(MarkStack *markStack) const;
-    void mark();
-    void sweep(bool lastSweep = false, ClassDestroyStatsCallback classCountPtr = nullptr);
+    CollectionType prepareCollection(CollectionType type);
+    void collectRootsAndRememberedSet(MarkStack *markStack, CollectionType type);
+    void mark(CollectionType type);
+    void sweep(bool lastSweep = false, ClassDestroyStatsCallback classCountPtr = nullptr, bool lazily = false);
     bool shouldRunGC() const;
+    bool canRunMinorCollection() const;
+    // Destroy callbacks run by the allocator's lazy sweep may allocate, but the chunk they
+    // are in is only half swept at that point.
+    bool isGCBlocked() const { return gcBlocked || blockAllocator.sweepingChunk; }
+    void collectForAllocation();
+    void startIncrementalGC(CollectionType type, GCStatistics::Trigger trigger);
     void collectRoots(MarkStack *markStack);
 
 public:
@@ -462,11 +508,21 @@ public:
 
     std::size_t unmanagedHeapSize = 0; // the amount of bytes of heap that is not managed by the memory manager, but which is held onto by managed items.
     std::size_t unmanagedHeapSizeGCLimit;
-    std::size_t usedSlotsAfterLastFullSweep = 0;
+    std::size_t usedSlotsAfterLastMajorCollection = 0;
 
     bool gcBlocked = false;
     bool aggressiveGC = false;
     bool gcStats = false;
+    bool generationalGC = false;
+    bool lazySweep = true;
+
+    qint64 incrementalGCStepBudget = 0; // in microseconds, 0 disables incremental marking
+    MarkStack *incrementalMarkStack = nullptr;
+    CollectionType incrementalCollectionType = MajorCollection;
+    GCStatistics::Trigger incrementalCollectionTrigger = GCStatistics::ExplicitTrigger; // what started it
+    std::size_t totalSlotsAtIncrementalGCStart = 0;
+
+    GCStatistics gcStatistics;
 };
 
 }
@@ -174,6 +174,13 @@ struct Chunk {
         return 0;
     }
 
+    uint nMarkedObjects() const {
+        uint marked = 0;
+        for (uint i = 0; i < EntriesInBitmap; ++i)
+            marked += qPopulationCount(blackBitmap[i]);
+        return marked;
+    }
+
     uint nFreeSlots() const {
         return AvailableSlots - nUsedSlots();
     }
@@ -186,6 +193,9 @@ struct Chunk {
         return usedSlots;
     }
 
+    // the slots that are used after the next sweep, computed from the mark bits
+    uint nLiveSlots() const;
+
     void sweep(ClassDestroyStatsCallback classCountPtr);
     void freeAll();
     void resetBlackBits();
@@ -283,8 +293,38 @@ struct MarkStack {\
         --top;
         return *top;
     }
+    bool isEmpty() const { return top == base; }
     void drain();
+    // returns true if the stack was drained before the time ran out
+    bool drain(qint64 nsecs);
+
+};
+
+// What a single garbage collection did, see MemoryManager::lastGCStatistics().
+struct GCStatistics
+{
+    enum Trigger {
+        ExplicitTrigger,        // gc(), QJSEngine::collectGarbage()
+        AllocationTrigger,      // the managed heap had no room left for an allocation
+        UnmanagedHeapTrigger,   // managed items hold too much memory outside of the heap
+        AggressiveTrigger       // QV4_MM_AGGRESSIVE_GC
+    };
 
+    quint64 sequenceNumber = 0; // 1 for the first collection of the engine, 0 if there was none
+    Trigger trigger = ExplicitTrigger;
+    bool minorCollection = false;
+    bool incremental = false;
+    qint64 markTime = 0;  // microseconds, only the final pause of an incremental collection
+    qint64 sweepTime = 0; // microseconds, chunks swept lazily later on are not included
+    // Chunks left for the allocator to sweep count with the objects that survived in them
+    std::size_t usedBefore = 0;
+    std::size_t usedAfter = 0;
+    std::size_t largeItemsBefore = 0;
+    std::size_t largeItemsAfter = 0;
+    std::size_t chunks = 0;
+    std::size_t releasedChunks = 0;
+    std::size_t unmanagedHeapBefore = 0;
+    std::size_t unmanagedHeapAfter = 0;
 };
 
 // Base class for the execution engine
@@ -313,6 +353,7 @@ Q_STATIC_ASSERT(std::is_standard_layout<EngineBase>::value);
 Q_STATIC_ASSERT(offsetof(EngineBase, current) == 0);
 Q_STATIC_ASSERT(offsetof(EngineBase, jsStackTop) == offsetof(EngineBase, current) + QT_POINTER_SIZE);
 Q_STATIC_ASSERT(offsetof(EngineBase, hasException) == offsetof(EngineBase, jsStackTop) + QT_POINTER_SIZE);
+Q_STATIC_ASSERT(offsetof(EngineBase, writeBarrierActive) == offsetof(EngineBase, hasException) + 1);
 Q_STATIC_ASSERT(offsetof(EngineBase, memoryManager) == offsetof(EngineBase, hasException) + QT_POINTER_SIZE);
 Q_STATIC_ASSERT(offsetof(EngineBase, runtime) == offsetof(EngineBase, memoryManager) + QT_POINTER_SIZE);
 
@@ -55,7 +55,24 @@
 
 QT_BEGIN_NAMESPACE
 
+// The qml-generational-gc feature (or defining V4_USE_STEELE_WRITEBARRIER) builds with a Steele
+// type barrier: stores of managed values into a heap object set that object's gray bit while
+// engine->writeBarrierActive is set. The memory manager relies on this for its generational
+// and incremental collections. It is on by default in developer builds only, so that the
+// tests cover it.
+//
+// Stores that deliberately bypass the barrier, as they only write into objects allocated right
+// before, with no collection in between: ValueArray::initialize(), the memcpy()s in
+// ArrayData::realloc(), MemberData::allocate(), ExecutionEngine::newArrayObject() and
+// Object::copyArrayData(). ValueArray::removeData() and the sort in ArrayData only move values
+// within the same object. Code writing through plain pointers calls WriteBarrier::markWritten().
+#if defined(V4_USE_STEELE_WRITEBARRIER) || QT_CONFIG(qml_generational_gc)
+#define WRITEBARRIER_steele 1
+#define WRITEBARRIER_none -1
+#else
+#define WRITEBARRIER_steele -1
 #define WRITEBARRIER_none 1
+#endif
 
 #define WRITEBARRIER(x) (1/WRITEBARRIER_##x == 1)
 
@@ -77,7 +94,50 @@ enum NewValueType {
 // ### this needs to be filled with a real memory fence once marking is concurrent
 Q_ALWAYS_INLINE void fence() {}
 
-#if WRITEBARRIER(none)
+#if WRITEBARRIER(steele)
+
+template <NewValueType type>
+static Q_CONSTEXPR inline bool isRequired() {
+    return type != Primitive;
+}
+
+inline void write(EngineBase *engine, Heap::Base *base, Value *slot, Value value)
+{
+    *slot = value;
+    if (engine->writeBarrierActive && value.isManaged()) {
+        fence();
+        base->setGrayBit();
+    }
+}
+
+inline void write(EngineBase *engine, Heap::Base *base, Value *slot, Heap::Base *value)
+{
+    *slot = value;
+    if (engine->writeBarrierActive && value) {
+        fence();
+        base->setGrayBit();
+    }
+}
+
+inline void write(EngineBase *engine, Heap::Base *base, Heap::Base **slot, Heap::Base *value)
+{
+    *slot = value;
+    if (engine->writeBarrierActive && value) {
+        fence();
+        base->setGrayBit();
+    }
+}
+
+// For code that stores into base through plain pointers. Has to be called after the stores.
+inline void markWritten(EngineBase *engine, Heap::Base *base)
+{
+    if (engine->writeBarrierActive) {
+        fence();
+        base->setGrayBit();
+    }
+}
+
+#elif WRITEBARRIER(none)
 
 template <NewValueType type>
 static Q_CONSTEXPR inline bool isRequired() {
@@ -105,6 +165,12 @@ inline void write(EngineBase *engine, Heap::Base *base, Heap::Base **slot, Heap:
     *slot = value;
 }
 
+inline void markWritten(EngineBase *engine, Heap::Base *base)
+{
+    Q_UNUSED(engine);
+    Q_UNUSED(base);
+}
+
 #endif
 
 }
@@ -169,6 +235,13 @@ struct ValueArray {
     void set(ExecutionEngine *e, uint index, Heap::Base *b) {
         WriteBarrier::write(e, base(), values + index, b);
     }
+    // Only valid right after allocating the item: the collector hasn't seen it yet, so
+    // the values don't need to go through the write barrier.
+    void initialize(uint index, const Value *v, uint n) {
+        Q_ASSERT(index + n <= alloc);
+        for (uint i = 0; i < n; ++i)
+            values[index + i] = v[i];
+    }
     inline const Value &operator[] (uint index) const {
         Q_ASSERT(index < alloc);
         return values[index];
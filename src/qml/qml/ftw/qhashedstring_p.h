@@ -248,14 +248,11 @@ public:
     inline bool equals(const QV4::String *string) const {
         if (length != string->d()->length() || hash != string->hashValue())
                 return false;
-        if (isQString()) {
-            QStringDataPtr dd;
-            dd.ptr = strData;
-            strData->ref.ref();
-            return QString(dd) == string->toQString();
-        } else {
-            return QLatin1String(cStrData(), length) == string->toQString();
-        }
+        // hashValue() has flattened the string, so compare its text in place rather than
+        // through temporary QStrings, which cost two atomic reference count updates each.
+        const QChar *data = reinterpret_cast<const QChar *>(string->d()->text->data());
+        return isQString() ? QHashedString::compare(data, (const QChar *)utf16Data(), length)
+                           : QHashedString::compare(data, cStrData(), length);
     }
 
     inline bool equals(const QHashedStringRef &string) const {
@@ -48,7 +48,8 @@ SOURCES += \
     $$PWD/qqmlobjectcreator.cpp \
     $$PWD/qqmldirparser.cpp \
     $$PWD/qqmldelayedcallqueue.cpp \
-    $$PWD/qqmlloggingcategory.cpp
+    $$PWD/qqmlloggingcategory.cpp \
+    $$PWD/qqmlstartuptrace.cpp
 
 HEADERS += \
     $$PWD/qqmlglobal_p.h \
@@ -118,7 +119,8 @@ HEADERS += \
     $$PWD/qqmlobjectcreator_p.h \
     $$PWD/qqmldirparser_p.h \
     $$PWD/qqmldelayedcallqueue_p.h \
-    $$PWD/qqmlloggingcategory_p.h
+    $$PWD/qqmlloggingcategory_p.h \
+    $$PWD/qqmlstartuptrace_p.h
 
 include(ftw/ftw.pri)
 include(v8/v8.pri)
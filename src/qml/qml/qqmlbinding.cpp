@@ -51,9 +51,12 @@
 #include <private/qqmlvaluetypewrapper_p.h>
 #include <private/qv4qobjectwrapper_p.h>
 #include <private/qv4variantobject_p.h>
+#include <private/qmetaobject_p.h>
 
 #include <QVariant>
+#include <QtCore/qcoreapplication.h>
 #include <QtCore/qdebug.h>
+#include <QtCore/qhash.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -76,7 +79,7 @@ QQmlBinding *QQmlBinding::create(const QQmlPropertyData *property, const QQmlScr
     if (engine && ctxtdata && !ctxtdata->urlString().isEmpty() && ctxtdata->typeCompilationUnit) {
         url = ctxtdata->urlString();
         if (scriptPrivate->bindingId != QQmlBinding::Invalid)
-            runtimeFunction = ctxtdata->typeCompilationUnit->runtimeFunctions.at(scriptPrivate->bindingId);
+            runtimeFunction = ctxtdata->typeCompilationUnit->runtimeFunction(scriptPrivate->bindingId);
     }
 
     b->setNotifyOnValueChanged(true);
@@ -125,6 +128,22 @@ QQmlBinding *QQmlBinding::create(const QQmlPropertyData *property, QV4::Function
     return b;
 }
 
+QQmlBinding *QQmlBinding::createPropertyRead(QV4::Function *function, QObject *obj, QQmlContextData *ctxt,
+                                             QV4::ExecutionContext *scope, int sourceIdIndex,
+                                             int sourcePropertyIndex)
+{
+    QQmlBinding *b = new QQmlPropertyReadBinding(sourceIdIndex, sourcePropertyIndex);
+
+    b->setNotifyOnValueChanged(true);
+    b->QQmlJavaScriptExpression::setContext(ctxt);
+    b->setScopeObject(obj);
+
+    Q_ASSERT(scope);
+    b->setupFunction(scope, function);
+
+    return b;
+}
+
 QQmlBinding::~QQmlBinding()
 {
 }
@@ -145,12 +164,7 @@ void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
 
     // Check for a binding update loop
     if (Q_UNLIKELY(updatingFlag())) {
-        QQmlPropertyData *d = nullptr;
-        QQmlPropertyData vtd;
-        getPropertyData(&d, &vtd);
-        Q_ASSERT(d);
-        QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, 0);
-        QQmlAbstractBinding::printBindingLoopError(p);
+        reportBindingLoop();
         return;
     }
     setUpdatingFlag(true);
@@ -195,7 +209,7 @@ class QQmlNonbindingBinding: public QQmlBinding
 {
 protected:
     void doUpdate(const DeleteWatcher &watcher,
-                  QQmlPropertyData::WriteFlags flags, QV4::Scope &scope) Q_DECL_OVERRIDE Q_DECL_FINAL
+                  QQmlPropertyData::WriteFlags flags, QV4::Scope &scope) Q_DECL_OVERRIDE
     {
         auto ep = QQmlEnginePrivate::get(scope.engine);
         ep->referenceScarceResources();
@@ -296,6 +310,81 @@ protected:
     }
 };
 
+// Copies a property of the scope object or of an object with an id, for bindings that the
+// type compiler found to do nothing else (see QQmlPropertyReadBindingAnnotator). When the
+// source object is gone, the JavaScript function runs instead and reports the usual error.
+class QQmlPropertyReadBinding: public GenericBinding<QMetaType::UnknownType>
+{
+public:
+    QQmlPropertyReadBinding(int sourceIdIndex, int sourcePropertyIndex)
+        : m_sourceIdIndex(sourceIdIndex)
+        , m_sourcePropertyIndex(sourcePropertyIndex)
+    {}
+
+protected:
+    void doUpdate(const DeleteWatcher &watcher,
+                  QQmlPropertyData::WriteFlags flags, QV4::Scope &scope) Q_DECL_OVERRIDE Q_DECL_FINAL
+    {
+        QQmlPropertyData *pd = nullptr;
+        QQmlPropertyData vpd;
+        getPropertyData(&pd, &vpd);
+        Q_ASSERT(pd);
+
+        QObject *source = sourceObject();
+        if (!source || vpd.isValid()) {
+            GenericBinding<QMetaType::UnknownType>::doUpdate(watcher, flags, scope);
+            return;
+        }
+
+        // Like QObjectWrapper::getProperty(), evaluate a binding on the source that has not
+        // run yet. This happens before the guards exist, so it does not notify us.
+        QQmlData::flushPendingBinding(source, QQmlPropertyIndex(m_sourcePropertyIndex));
+
+        // Registering the guards here also keeps the JavaScript fallback from registering
+        // the id object dependency a second time.
+        if (!permanentDependenciesRegistered()) {
+            QQmlPropertyCapture capture(context()->engine, this, const_cast<DeleteWatcher *>(&watcher));
+            if (m_sourceIdIndex != QV4::CompiledData::Binding::NoSourceId)
+                capture.captureProperty(&context()->idValues[m_sourceIdIndex].bindings, QQmlPropertyCapture::Permanently);
+            const QMetaProperty sourceProperty = source->metaObject()->property(m_sourcePropertyIndex);
+            if (sourceProperty.hasNotifySignal()) {
+                capture.captureProperty(source, m_sourcePropertyIndex,
+                                        QMetaObjectPrivate::signalIndex(sourceProperty.notifySignal()),
+                                        QQmlPropertyCapture::Permanently);
+            }
+            setPermanentDependenciesRegistered();
+        }
+
+        QQmlEnginePrivate *ep = QQmlEnginePrivate::get(scope.engine);
+        if (!ep->pendingBindingUpdates.isEmpty())
+            QQmlBinding::updatePendingBinding(source, m_sourcePropertyIndex);
+
+        QVariant value(pd->propType(), (const void *)0);
+        void *args[] = { value.data(), 0 };
+        QMetaObject::metacall(source, QMetaObject::ReadProperty, m_sourcePropertyIndex, args);
+
+        if (!watcher.wasDeleted() && isAddedToObject()) {
+            pd->writeProperty(targetObject(), value.data(), flags);
+            if (!watcher.wasDeleted()) {
+                clearError();
+                cancelPermanentGuards();
+            }
+        }
+    }
+
+private:
+    QObject *sourceObject() const
+    {
+        if (m_sourceIdIndex == QV4::CompiledData::Binding::NoSourceId)
+            return scopeObject();
+        QQmlContextData *ctxt = context();
+        return m_sourceIdIndex < ctxt->idValueCount ? ctxt->idValues[m_sourceIdIndex].data() : 0;
+    }
+
+    int m_sourceIdIndex;
+    int m_sourcePropertyIndex;
+};
+
 Q_NEVER_INLINE bool QQmlBinding::slowWrite(const QQmlPropertyData &core,
                                            const QQmlPropertyData &valueTypeData,
                                            const QV4::Value &result,
@@ -431,9 +520,98 @@ QString QQmlBinding::expressionIdentifier() const
 
 void QQmlBinding::expressionChanged()
 {
+    QQmlContextData *ctxt = context();
+    if (ctxt && ctxt->engine && QQmlEnginePrivate::get(ctxt->engine)->deferBindingUpdates) {
+        scheduleUpdate(ctxt->engine);
+        return;
+    }
+
     update();
 }
 
+void QQmlBinding::scheduleUpdate(QQmlEngine *engine)
+{
+    if (isUpdatePending())
+        return;
+
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(engine);
+    setUpdatePending(true);
+    ep->pendingBindingUpdates.append(QQmlAbstractBinding::Ptr(this));
+    if (!ep->bindingUpdatesPosted) {
+        ep->bindingUpdatesPosted = true;
+        QCoreApplication::postEvent(engine, new QEvent(QQmlEnginePrivate::bindingUpdateEvent()));
+    }
+}
+
+/*
+    Updates the bindings that were scheduled by expressionChanged() since the last call.
+
+    Bindings scheduled while this runs are appended to the queue and handled in the same
+    pass, so a chain of dependent bindings settles before control returns to the event
+    loop. Whoever reads a property with a pending binding gets it updated first (see
+    updatePendingBinding()), which makes each binding of a diamond-shaped dependency
+    evaluate once, after its inputs. A binding that keeps getting scheduled again within
+    one pass is part of a binding loop: it is reported and dropped from the queue.
+*/
+void QQmlBinding::updatePendingBindings(QQmlEngine *engine)
+{
+    static const int maxUpdatesPerPass = 16;
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(engine);
+
+    QHash<QQmlAbstractBinding *, int> updateCounts;
+    for (int i = 0; i < ep->pendingBindingUpdates.count(); ++i) {
+        QQmlAbstractBinding::Ptr b = ep->pendingBindingUpdates.at(i);
+        QQmlBinding *binding = static_cast<QQmlBinding *>(b.data());
+        if (!binding->isUpdatePending())
+            continue; // already updated on demand
+        int &updateCount = updateCounts[binding];
+        if (updateCount >= maxUpdatesPerPass) {
+            // only warn once, the other bindings of the loop may schedule it again
+            if (updateCount++ == maxUpdatesPerPass)
+                binding->reportBindingLoop();
+            binding->setUpdatePending(false);
+            continue;
+        }
+        ++updateCount;
+        // Keep the flag set while updating, so that notifications for dependencies
+        // that get updated on demand do not schedule this binding again.
+        binding->update();
+        binding->setUpdatePending(false);
+    }
+
+    ep->pendingBindingUpdates.clear();
+    ep->bindingUpdatesPosted = false;
+}
+
+/*
+    Called before a property is read from JavaScript while binding updates are pending.
+    Updates the binding of that property first if it is one of them.
+*/
+void QQmlBinding::updatePendingBinding(QObject *object, int coreIndex)
+{
+    QQmlAbstractBinding *b = QQmlPropertyPrivate::binding(object, QQmlPropertyIndex(coreIndex));
+    if (!b || b->isValueTypeProxy())
+        return;
+
+    QQmlBinding *binding = static_cast<QQmlBinding *>(b);
+    if (!binding->isUpdatePending() || binding->updatingFlag())
+        return;
+
+    QQmlAbstractBinding::Ptr guard(binding);
+    binding->update();
+    binding->setUpdatePending(false);
+}
+
+void QQmlBinding::reportBindingLoop()
+{
+    QQmlPropertyData *d = nullptr;
+    QQmlPropertyData vtd;
+    getPropertyData(&d, &vtd);
+    Q_ASSERT(d);
+    QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, 0);
+    QQmlAbstractBinding::printBindingLoopError(p);
+}
+
 void QQmlBinding::refresh()
 {
     update();
@@ -77,6 +77,9 @@ public:
                                const QString &url = QString(), quint16 lineNumber = 0);
     static QQmlBinding *create(const QQmlPropertyData *property, QV4::Function *function,
                                QObject *obj, QQmlContextData *ctxt, QV4::ExecutionContext *scope);
+    static QQmlBinding *createPropertyRead(QV4::Function *function, QObject *obj, QQmlContextData *ctxt,
+                                           QV4::ExecutionContext *scope, int sourceIdIndex,
+                                           int sourcePropertyIndex);
     ~QQmlBinding();
 
     void setTarget(const QQmlProperty &);
@@ -100,6 +103,9 @@ public:
     QString expressionIdentifier() const override;
     void expressionChanged() override;
 
+    static void updatePendingBindings(QQmlEngine *engine);
+    static void updatePendingBinding(QObject *object, int coreIndex);
+
 protected:
     virtual void doUpdate(const DeleteWatcher &watcher,
                           QQmlPropertyData::WriteFlags flags, QV4::Scope &scope) = 0;
@@ -116,6 +122,9 @@ private:
     inline bool enabledFlag() const;
     inline void setEnabledFlag(bool);
 
+    void scheduleUpdate(QQmlEngine *engine);
+    void reportBindingLoop();
+
     static QQmlBinding *newBinding(QQmlEnginePrivate *engine, const QQmlPropertyData *property);
 };
 
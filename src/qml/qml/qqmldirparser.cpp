@@ -61,14 +61,14 @@ static int parseInt(const QStringRef &str, bool *ok)
     return number;
 }
 
-static bool parseVersion(const QString &str, int *major, int *minor)
+static bool parseVersion(const QStringRef &str, int *major, int *minor)
 {
     const int dotIndex = str.indexOf(QLatin1Char('.'));
     if (dotIndex != -1 && str.indexOf(QLatin1Char('.'), dotIndex + 1) == -1) {
         bool ok = false;
-        *major = parseInt(QStringRef(&str, 0, dotIndex), &ok);
+        *major = parseInt(str.left(dotIndex), &ok);
         if (ok)
-            *minor = parseInt(QStringRef(&str, dotIndex + 1, str.length() - dotIndex - 1), &ok);
+            *minor = parseInt(str.mid(dotIndex + 1), &ok);
         return ok;
     }
     return false;
@@ -126,7 +126,8 @@ bool QQmlDirParser::parse(const QString &source)
         if (ch->isNull())
             break;
 
-        QString sections[4];
+        // The tokens only refer into source; the directives below copy what they keep.
+        QStringRef sections[4];
         int sectionCount = 0;
 
         do {
@@ -137,7 +138,7 @@ bool QQmlDirParser::parse(const QString &source)
             const QChar *start = ch;
             scanWord(ch);
             if (sectionCount < 4) {
-                sections[sectionCount++] = source.mid(start-source.constData(), ch-start);
+                sections[sectionCount++] = QStringRef(&source, start-source.constData(), ch-start);
             } else {
                 reportError(lineNumber, start-lineStart, QLatin1String("unexpected token"));
                 scanToEnd(ch);
@@ -174,7 +175,7 @@ bool QQmlDirParser::parse(const QString &source)
                 continue;
             }
 
-            _typeNamespace = sections[1];
+            _typeNamespace = sections[1].toString();
 
         } else if (sections[0] == QLatin1String("plugin")) {
             if (sectionCount < 2 || sectionCount > 3) {
@@ -184,7 +185,7 @@ bool QQmlDirParser::parse(const QString &source)
                 continue;
             }
 
-            const Plugin entry(sections[1], sections[2]);
+            const Plugin entry(sections[1].toString(), sections[2].toString());
 
             _plugins.append(entry);
 
@@ -203,7 +204,7 @@ bool QQmlDirParser::parse(const QString &source)
                             QStringLiteral("internal types require 2 arguments, but %1 were provided").arg(sectionCount - 1));
                 continue;
             }
-            Component entry(sections[1], sections[2], -1, -1);
+            Component entry(sections[1].toString(), sections[2].toString(), -1, -1);
             entry.internal = true;
             _components.insertMulti(entry.typeName, entry);
         } else if (sections[0] == QLatin1String("singleton")) {
@@ -214,7 +215,7 @@ bool QQmlDirParser::parse(const QString &source)
             } else if (sectionCount == 3) {
                 // handle qmldir directory listing case where singleton is defined in the following pattern:
                 // singleton TestSingletonType TestSingletonType.qml
-                Component entry(sections[1], sections[2], -1, -1);
+                Component entry(sections[1].toString(), sections[2].toString(), -1, -1);
                 entry.singleton = true;
                 _components.insertMulti(entry.typeName, entry);
             } else {
@@ -222,12 +223,11 @@ bool QQmlDirParser::parse(const QString &source)
                 // singleton TestSingletonType 2.0 TestSingletonType20.qml
                 int major, minor;
                 if (parseVersion(sections[2], &major, &minor)) {
-                    const QString &fileName = sections[3];
-                    Component entry(sections[1], fileName, major, minor);
+                    Component entry(sections[1].toString(), sections[3].toString(), major, minor);
                     entry.singleton = true;
                     _components.insertMulti(entry.typeName, entry);
                 } else {
-                    reportError(lineNumber, 0, QStringLiteral("invalid version %1, expected <major>.<minor>").arg(sections[2]));
+                    reportError(lineNumber, 0, QStringLiteral("invalid version %1, expected <major>.<minor>").arg(sections[2].toString()));
                 }
             }
         } else if (sections[0] == QLatin1String("typeinfo")) {
@@ -237,7 +237,7 @@ bool QQmlDirParser::parse(const QString &source)
                 continue;
             }
 #ifdef QT_CREATOR
-            TypeInfo typeInfo(sections[1]);
+            TypeInfo typeInfo(sections[1].toString());
             _typeInfos.append(typeInfo);
 #endif
 
@@ -255,31 +255,31 @@ bool QQmlDirParser::parse(const QString &source)
 
             int major, minor;
             if (parseVersion(sections[2], &major, &minor)) {
-                Component entry(sections[1], QString(), major, minor);
+                Component entry(sections[1].toString(), QString(), major, minor);
                 entry.internal = true;
                 _dependencies.insert(entry.typeName, entry);
             } else {
-                reportError(lineNumber, 0, QStringLiteral("invalid version %1, expected <major>.<minor>").arg(sections[2]));
+                reportError(lineNumber, 0, QStringLiteral("invalid version %1, expected <major>.<minor>").arg(sections[2].toString()));
             }
         } else if (sectionCount == 2) {
             // No version specified (should only be used for relative qmldir files)
-            const Component entry(sections[0], sections[1], -1, -1);
+            const Component entry(sections[0].toString(), sections[1].toString(), -1, -1);
             _components.insertMulti(entry.typeName, entry);
         } else if (sectionCount == 3) {
             int major, minor;
             if (parseVersion(sections[1], &major, &minor)) {
-                const QString &fileName = sections[2];
+                const QStringRef &fileName = sections[2];
 
                 if (fileName.endsWith(QLatin1String(".js"))) {
                     // A 'js' extension indicates a namespaced script import
-                    const Script entry(sections[0], fileName, major, minor);
+                    const Script entry(sections[0].toString(), fileName.toString(), major, minor);
                     _scripts.append(entry);
                 } else {
-                    const Component entry(sections[0], fileName, major, minor);
+                    const Component entry(sections[0].toString(), fileName.toString(), major, minor);
                     _components.insertMulti(entry.typeName, entry);
                 }
             } else {
-                reportError(lineNumber, 0, QStringLiteral("invalid version %1, expected <major>.<minor>").arg(sections[1]));
+                reportError(lineNumber, 0, QStringLiteral("invalid version %1, expected <major>.<minor>").arg(sections[1].toString()));
             }
         } else {
             reportError(lineNumber, 0,
@@ -60,6 +60,7 @@
 #include "qqmlincubator.h"
 #include "qqmlabstracturlinterceptor.h"
 #include <private/qqmlboundsignal_p.h>
+#include <private/qqmlbinding_p.h>
 #include <QtCore/qstandardpaths.h>
 #include <QtCore/qsettings.h>
 #include <QtCore/qmetaobject.h>
@@ -93,6 +94,7 @@
 #include <private/qquickworkerscript_p.h>
 #include <private/qqmlinstantiator_p.h>
 #include <private/qqmlloggingcategory_p.h>
+#include <private/qqmlstartuptrace_p.h>
 
 #ifdef Q_OS_WIN // for %APPDATA%
 #  include <qt_windows.h>
@@ -665,7 +667,7 @@ QQmlEnginePrivate::QQmlEnginePrivate(QQmlEngine *e)
 #endif
   outputWarningsToMsgLog(true),
   cleanup(0), erroredBindings(0), inProgressCreations(0),
-  workerScriptEngine(0),
+  deferBindingUpdates(false), bindingUpdatesPosted(false),
   activeObjectCreator(0),
 #if QT_CONFIG(qml_network)
   networkAccessManager(0), networkAccessManagerFactory(0),
@@ -907,6 +909,8 @@ void QQmlData::flushPendingBindingImpl(QQmlPropertyIndex index)
                             QQmlPropertyData::DontRemoveBinding);
 }
 
+DEFINE_BOOL_CONFIG_OPTION(deferredBindingUpdates, QML_DEFERRED_BINDINGS)
+
 bool QQmlEnginePrivate::baseModulesUninitialized = true;
 void QQmlEnginePrivate::init()
 {
@@ -919,6 +923,9 @@ void QQmlEnginePrivate::init()
 
         QQmlData::init();
         baseModulesUninitialized = false;
+
+        if (Q_UNLIKELY(!qEnvironmentVariableIsEmpty("QML_STARTUP_TRACE")))
+            QQmlStartupTrace::start(QString::fromLocal8Bit(qgetenv("QML_STARTUP_TRACE")));
     }
 
     qRegisterMetaType<QVariant>();
@@ -933,14 +940,42 @@ void QQmlEnginePrivate::init()
     v8engine()->setEngine(q);
 
     rootContext = new QQmlContext(q,true);
+
+    deferBindingUpdates = deferredBindingUpdates();
 }
 
+static int maxWorkerScriptThreads()
+{
+    bool ok = false;
+    int threads = qEnvironmentVariableIntValue("QML_WORKERSCRIPT_MAX_THREADS", &ok);
+    if (!ok)
+        threads = 1;
+    return qMax(1, threads);
+}
+
+/*
+   Each WorkerScript is pinned to one worker thread for its whole lifetime, so
+   messages to the same worker stay ordered and its JavaScript state lives in a
+   single engine. New workers go to the least busy thread; another thread is
+   started only while all existing ones are in use and the pool is below
+   QML_WORKERSCRIPT_MAX_THREADS. The pool is opt-in: by default all workers share
+   one thread, as a ListModel sent to several workers can only be used from one.
+*/
 QQuickWorkerScriptEngine *QQmlEnginePrivate::getWorkerScriptEngine()
 {
     Q_Q(QQmlEngine);
-    if (!workerScriptEngine)
-        workerScriptEngine = new QQuickWorkerScriptEngine(q);
-    return workerScriptEngine;
+    QQuickWorkerScriptEngine *leastBusy = 0;
+    for (QQuickWorkerScriptEngine *engine : qAsConst(workerScriptEngines)) {
+        if (!leastBusy || engine->workerScriptCount() < leastBusy->workerScriptCount())
+            leastBusy = engine;
+    }
+
+    if (!leastBusy || (leastBusy->workerScriptCount() > 0
+                       && workerScriptEngines.count() < maxWorkerScriptThreads())) {
+        leastBusy = new QQuickWorkerScriptEngine(q);
+        workerScriptEngines.append(leastBusy);
+    }
+    return leastBusy;
 }
 
 /*!
@@ -1026,6 +1061,8 @@ QQmlEngine::~QQmlEngine()
     for (QQmlType *currType : singletonTypes)
         currType->singletonInstanceInfo()->destroy(this);
 
+    d->pendingBindingUpdates.clear();
+
     delete d->rootContext;
     d->rootContext = 0;
 }
@@ -1441,10 +1478,18 @@ bool QQmlEngine::event(QEvent *e)
     Q_D(QQmlEngine);
     if (e->type() == QEvent::User)
         d->doDeleteInEngineThread();
+    else if (e->type() == QQmlEnginePrivate::bindingUpdateEvent())
+        QQmlBinding::updatePendingBindings(this);
 
     return QJSEngine::event(e);
 }
 
+QEvent::Type QQmlEnginePrivate::bindingUpdateEvent()
+{
+    static const QEvent::Type type = QEvent::Type(QEvent::registerEventType());
+    return type;
+}
+
 void QQmlEnginePrivate::doDeleteInEngineThread()
 {
     QFieldList<Deletable, &Deletable::next> list;
@@ -62,6 +62,7 @@
 #include "qqmlcontext_p.h"
 #include "qqmlexpression.h"
 #include "qqmlproperty_p.h"
+#include "qqmlabstractbinding_p.h"
 #include "qqmlpropertycache_p.h"
 #include "qqmlmetatype_p.h"
 #include "qqmldirparser_p.h"
@@ -75,6 +76,7 @@
 #include <QtCore/qmutex.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qvector.h>
 
 #include <private/qobject_p.h>
 
@@ -150,11 +152,18 @@ public:
     QQmlDelayedError *erroredBindings;
     int inProgressCreations;
 
+    // Bindings whose re-evaluation is deferred until control returns to the event loop.
+    // Enabled with QML_DEFERRED_BINDINGS, see QQmlBinding::expressionChanged().
+    static QEvent::Type bindingUpdateEvent();
+    bool deferBindingUpdates;
+    bool bindingUpdatesPosted;
+    QVector<QQmlAbstractBinding::Ptr> pendingBindingUpdates;
+
     QV8Engine *v8engine() const { return q_func()->handle(); }
     QV4::ExecutionEngine *v4engine() const { return QV8Engine::getV4(q_func()->handle()); }
 
     QQuickWorkerScriptEngine *getWorkerScriptEngine();
-    QQuickWorkerScriptEngine *workerScriptEngine;
+    QVector<QQuickWorkerScriptEngine *> workerScriptEngines;
 
     QUrl baseUrl;
 
@@ -47,12 +47,20 @@
 #include <QtCore/qpluginloader.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/qreadwritelock.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qstandardpaths.h>
 #include <QtQml/qqmlextensioninterface.h>
 #include <QtQml/qqmlextensionplugin.h>
 #include <private/qqmlextensionplugin_p.h>
 #include <private/qqmlglobal_p.h>
 #include <private/qqmltypenamecache_p.h>
 #include <private/qqmlengine_p.h>
+#include <private/qqmlprofiler_p.h>
+#include <private/qqmlstartuptrace_p.h>
 #include <private/qfieldlist_p.h>
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qjsonarray.h>
@@ -64,6 +72,13 @@ QT_BEGIN_NAMESPACE
 
 DEFINE_BOOL_CONFIG_OPTION(qmlImportTrace, QML_IMPORT_TRACE)
 DEFINE_BOOL_CONFIG_OPTION(qmlCheckTypes, QML_CHECK_TYPES)
+// Read for each import database rather than once per process, like the options above, so that
+// tests can enable it for a single engine.
+static bool qmlImportCacheRequested()
+{
+    const QByteArray value = qgetenv("QML_IMPORT_CACHE");
+    return !value.isEmpty() && value != "0" && value != "false";
+}
 
 static const QLatin1Char Dot('.');
 static const QLatin1Char Slash('/');
@@ -75,6 +90,177 @@ static const QString dotqml_string(QStringLiteral(".qml"));
 static const QString dotuidotqml_string(QStringLiteral(".ui.qml"));
 static bool designerSupportRequired = false;
 
+/*
+    Remembers where the qmldir files and plugins of modules were found in previous runs,
+    so that an application starting with the same import and plugin paths does not have
+    to probe every one of them again.
+
+    The cache file is selected by the path lists and is discarded when the modification
+    time of one of the local import directories changes. Each entry is validated against
+    the modification time of the file it points to before it is used. Negative results
+    and files in resources are not stored.
+*/
+class QQmlImportResolutionCache
+{
+public:
+    QQmlImportResolutionCache(const QStringList &importPaths, const QStringList &pluginPaths);
+    ~QQmlImportResolutionCache();
+
+    QString qmldirFilePath(const QString &uri, int vmaj, int vmin)
+    { return lookup(qmldirKey(uri, vmaj, vmin)); }
+    void insertQmldirFilePath(const QString &uri, int vmaj, int vmin, const QString &filePath)
+    { insert(qmldirKey(uri, vmaj, vmin), filePath); }
+
+    QString pluginFilePath(const QString &qmldirPath, const QString &qmldirPluginPath, const QString &fileName)
+    { return lookup(pluginKey(qmldirPath, qmldirPluginPath, fileName)); }
+    void insertPluginFilePath(const QString &qmldirPath, const QString &qmldirPluginPath, const QString &fileName, const QString &filePath)
+    { insert(pluginKey(qmldirPath, qmldirPluginPath, fileName), filePath); }
+
+private:
+    enum { Magic = 0x51494d50, Version = 1 }; // 'QIMP'
+
+    struct Entry {
+        QString filePath;
+        qint64 lastModified;
+    };
+
+    static QString qmldirKey(const QString &uri, int vmaj, int vmin)
+    { return QLatin1String("qmldir:") + uri + Slash + QString::number(vmaj) + Dot + QString::number(vmin); }
+    static QString pluginKey(const QString &qmldirPath, const QString &qmldirPluginPath, const QString &fileName)
+    { return QLatin1String("plugin:") + qmldirPath + QLatin1Char('\n') + qmldirPluginPath + QLatin1Char('\n') + fileName; }
+    static qint64 lastModified(const QString &filePath)
+    { return QFileInfo(filePath).lastModified().toMSecsSinceEpoch(); }
+
+    QString lookup(const QString &key);
+    void insert(const QString &key, const QString &filePath);
+    void load();
+    void save() const;
+
+    // The type loader thread and the GUI thread may both resolve imports.
+    QMutex m_mutex;
+    QString m_cacheFilePath;
+    QByteArray m_fingerprint;
+    QHash<QString, Entry> m_entries;
+    bool m_dirty;
+};
+
+QQmlImportResolutionCache::QQmlImportResolutionCache(const QStringList &importPaths, const QStringList &pluginPaths)
+    : m_dirty(false)
+{
+    QCryptographicHash pathsHash(QCryptographicHash::Sha1);
+    for (const QString &path : importPaths)
+        pathsHash.addData(path.toUtf8() + '\0');
+    pathsHash.addData("\0", 1);
+    for (const QString &path : pluginPaths)
+        pathsHash.addData(path.toUtf8() + '\0');
+
+    const QString directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/qmlcache/");
+    m_cacheFilePath = directory + QLatin1String("imports-") + QString::fromLatin1(pathsHash.result().toHex()) + QLatin1String(".cache");
+
+    // Installing a module usually adds a directory to one of the import paths, which would
+    // shadow a location found further down the list, so start over when any of them changed.
+    QDataStream fingerprint(&m_fingerprint, QIODevice::WriteOnly);
+    for (const QString &path : importPaths) {
+        const QString localPath = QQmlFile::isLocalFile(path) ? QQmlFile::urlToLocalFileOrQrc(path) : path;
+        const bool isDirectory = !localPath.startsWith(Colon) && QDir::isAbsolutePath(localPath);
+        fingerprint << (isDirectory ? lastModified(localPath) : qint64(0));
+    }
+
+    load();
+}
+
+QQmlImportResolutionCache::~QQmlImportResolutionCache()
+{
+    if (m_dirty)
+        save();
+}
+
+QString QQmlImportResolutionCache::lookup(const QString &key)
+{
+    QMutexLocker locker(&m_mutex);
+    QHash<QString, Entry>::Iterator it = m_entries.find(key);
+    if (it == m_entries.end())
+        return QString();
+
+    if (lastModified(it->filePath) != it->lastModified) {
+        m_entries.erase(it);
+        m_dirty = true;
+        return QString();
+    }
+
+    return it->filePath;
+}
+
+void QQmlImportResolutionCache::insert(const QString &key, const QString &filePath)
+{
+    if (filePath.startsWith(Colon))
+        return;
+
+    const Entry entry = { filePath, lastModified(filePath) };
+    QMutexLocker locker(&m_mutex);
+    m_entries.insert(key, entry);
+    m_dirty = true;
+}
+
+void QQmlImportResolutionCache::load()
+{
+    QFile file(m_cacheFilePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != quint32(Magic) || version != quint32(Version))
+        return;
+    stream.setVersion(QDataStream::Qt_5_9);
+
+    QByteArray fingerprint;
+    stream >> fingerprint;
+    if (fingerprint != m_fingerprint) {
+        // Stale, rewrite it with what is found during this run.
+        m_dirty = true;
+        return;
+    }
+
+    quint32 count = 0;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString key;
+        Entry entry;
+        stream >> key >> entry.filePath >> entry.lastModified;
+        m_entries.insert(key, entry);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        m_entries.clear();
+        m_dirty = true;
+    }
+
+    if (qmlImportTrace())
+        qDebug().nospace() << "QQmlImportResolutionCache: loaded " << m_entries.count() << " entries from " << m_cacheFilePath;
+}
+
+void QQmlImportResolutionCache::save() const
+{
+    QDir::root().mkpath(QFileInfo(m_cacheFilePath).absolutePath());
+
+    QSaveFile file(m_cacheFilePath);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream << quint32(Magic) << quint32(Version);
+    stream.setVersion(QDataStream::Qt_5_9);
+    stream << m_fingerprint << quint32(m_entries.count());
+    for (QHash<QString, Entry>::ConstIterator it = m_entries.constBegin(), end = m_entries.constEnd(); it != end; ++it)
+        stream << it.key() << it->filePath << it->lastModified;
+
+    if (stream.status() == QDataStream::Ok)
+        file.commit();
+}
+
 namespace {
 
 QString resolveLocalUrl(const QString &url, const QString &relative)
@@ -1229,35 +1415,50 @@ bool QQmlImportsPrivate::locateQmldir(const QString &uri, int vmaj, int vmin, QQ
     }
     }
 
+    QQmlStartupTrace::Range traceRange(QQmlStartupTrace::ResolveQmldir, uri);
+    QQmlCompilingProfiler prof(QQmlEnginePrivate::get(database->engine)->profiler, uri);
     QQmlTypeLoader &typeLoader = QQmlEnginePrivate::get(database->engine)->typeLoader;
 
-    QStringList localImportPaths = database->importPathList(QQmlImportDatabase::Local);
-
-    // Search local import paths for a matching version
-    const QStringList qmlDirPaths = QQmlImports::completeQmldirPaths(uri, localImportPaths, vmaj, vmin);
-    for (const QString &qmldirPath : qmlDirPaths) {
-        QString absoluteFilePath = typeLoader.absoluteFilePath(qmldirPath);
-        if (!absoluteFilePath.isEmpty()) {
-            QString url;
-            const QStringRef absolutePath = absoluteFilePath.leftRef(absoluteFilePath.lastIndexOf(Slash) + 1);
-            if (absolutePath.at(0) == Colon)
-                url = QLatin1String("qrc://") + absolutePath.mid(1);
-            else
-                url = QUrl::fromLocalFile(absolutePath.toString()).toString();
+    QString absoluteFilePath;
+    const QSharedPointer<QQmlImportResolutionCache> persistentCache = database->resolutionCache();
+    if (persistentCache)
+        absoluteFilePath = persistentCache->qmldirFilePath(uri, vmaj, vmin);
+
+    if (absoluteFilePath.isEmpty()) {
+        QStringList localImportPaths = database->importPathList(QQmlImportDatabase::Local);
+
+        // Search local import paths for a matching version
+        const QStringList qmlDirPaths = QQmlImports::completeQmldirPaths(uri, localImportPaths, vmaj, vmin);
+        for (const QString &qmldirPath : qmlDirPaths) {
+            absoluteFilePath = typeLoader.absoluteFilePath(qmldirPath);
+            if (!absoluteFilePath.isEmpty()) {
+                if (persistentCache)
+                    persistentCache->insertQmldirFilePath(uri, vmaj, vmin, absoluteFilePath);
+                break;
+            }
+        }
+    }
 
-            QQmlImportDatabase::QmldirCache *cache = new QQmlImportDatabase::QmldirCache;
-            cache->versionMajor = vmaj;
-            cache->versionMinor = vmin;
-            cache->qmldirFilePath = absoluteFilePath;
-            cache->qmldirPathUrl = url;
-            cache->next = cacheHead;
-            database->qmldirCache.insert(uri, cache);
+    if (!absoluteFilePath.isEmpty()) {
+        QString url;
+        const QStringRef absolutePath = absoluteFilePath.leftRef(absoluteFilePath.lastIndexOf(Slash) + 1);
+        if (absolutePath.at(0) == Colon)
+            url = QLatin1String("qrc://") + absolutePath.mid(1);
+        else
+            url = QUrl::fromLocalFile(absolutePath.toString()).toString();
 
-            *outQmldirFilePath = absoluteFilePath;
-            *outQmldirPathUrl = url;
+        QQmlImportDatabase::QmldirCache *cache = new QQmlImportDatabase::QmldirCache;
+        cache->versionMajor = vmaj;
+        cache->versionMinor = vmin;
+        cache->qmldirFilePath = absoluteFilePath;
+        cache->qmldirPathUrl = url;
+        cache->next = cacheHead;
+        database->qmldirCache.insert(uri, cache);
 
-            return true;
-        }
+        *outQmldirFilePath = absoluteFilePath;
+        *outQmldirPathUrl = url;
+
+        return true;
     }
 
     QQmlImportDatabase::QmldirCache *cache = new QQmlImportDatabase::QmldirCache;
@@ -1670,7 +1871,7 @@ void QQmlImports::setDesignerSupportRequired(bool b)
 \internal
 */
 QQmlImportDatabase::QQmlImportDatabase(QQmlEngine *e)
-: engine(e)
+: persistentCacheEnabled(qmlImportCacheRequested()), engine(e)
 {
     filePluginPath << QLatin1String(".");
     // Search order is applicationDirPath(), qrc:/qt-project.org/imports, $QML2_IMPORT_PATH, QLibraryInfo::Qml2ImportsPath
@@ -1700,6 +1901,26 @@ QQmlImportDatabase::~QQmlImportDatabase()
     clearDirCache();
 }
 
+/*!
+  \internal
+
+  Returns the persistent cache of resolved qmldir and plugin locations for the current
+  import and plugin paths, or null if it is not enabled with QML_IMPORT_CACHE.
+
+  The type loader thread resolves imports while the GUI thread may change the paths, so
+  callers keep their own reference to the cache for as long as they use it. The path setters
+  drop the cache under the same mutex.
+ */
+QSharedPointer<QQmlImportResolutionCache> QQmlImportDatabase::resolutionCache()
+{
+    if (!persistentCacheEnabled)
+        return QSharedPointer<QQmlImportResolutionCache>();
+    QMutexLocker locker(&persistentCacheMutex);
+    if (!persistentCache)
+        persistentCache.reset(new QQmlImportResolutionCache(fileImportPath, filePluginPath));
+    return persistentCache;
+}
+
 /*!
   \internal
 
@@ -1714,6 +1935,13 @@ QString QQmlImportDatabase::resolvePlugin(QQmlTypeLoader *typeLoader,
                                           const QString &baseName, const QStringList &suffixes,
                                           const QString &prefix)
 {
+    const QSharedPointer<QQmlImportResolutionCache> persistentCache = resolutionCache();
+    if (persistentCache) {
+        const QString cachedPath = persistentCache->pluginFilePath(qmldirPath, qmldirPluginPath, prefix + baseName);
+        if (!cachedPath.isEmpty())
+            return cachedPath;
+    }
+
     QStringList searchPaths = filePluginPath;
     bool qmldirPluginPathIsRelative = QDir::isRelativePath(qmldirPluginPath);
     if (!qmldirPluginPathIsRelative)
@@ -1743,8 +1971,11 @@ QString QQmlImportDatabase::resolvePlugin(QQmlTypeLoader *typeLoader,
         resolvedPath += prefix + baseName;
         for (const QString &suffix : suffixes) {
             const QString absolutePath = typeLoader->absoluteFilePath(resolvedPath + suffix);
-            if (!absolutePath.isEmpty())
+            if (!absolutePath.isEmpty()) {
+                if (persistentCache)
+                    persistentCache->insertPluginFilePath(qmldirPath, qmldirPluginPath, prefix + baseName, absolutePath);
                 return absolutePath;
+            }
         }
     }
 
@@ -1818,7 +2049,9 @@ void QQmlImportDatabase::setPluginPathList(const QStringList &paths)
     if (qmlImportTrace())
         qDebug().nospace() << "QQmlImportDatabase::setPluginPathList: " << paths;
 
+    QMutexLocker locker(&persistentCacheMutex);
     filePluginPath = paths;
+    persistentCache.reset();
 }
 
 /*!
@@ -1830,6 +2063,7 @@ void QQmlImportDatabase::addPluginPath(const QString& path)
         qDebug().nospace() << "QQmlImportDatabase::addPluginPath: " << path;
 
     QUrl url = QUrl(path);
+    QMutexLocker locker(&persistentCacheMutex);
     if (url.isRelative() || url.scheme() == QLatin1String("file")
             || (url.scheme().length() == 1 && QFile::exists(path)) ) {  // windows path
         QDir dir = QDir(path);
@@ -1837,6 +2071,7 @@ void QQmlImportDatabase::addPluginPath(const QString& path)
     } else {
         filePluginPath.prepend(path);
     }
+    persistentCache.reset();
 }
 
 /*!
@@ -1870,8 +2105,11 @@ void QQmlImportDatabase::addImportPath(const QString& path)
     }
 
     if (!cPath.isEmpty()
-        && !fileImportPath.contains(cPath))
+        && !fileImportPath.contains(cPath)) {
+        QMutexLocker locker(&persistentCacheMutex);
         fileImportPath.prepend(cPath);
+        persistentCache.reset();
+    }
 }
 
 /*!
@@ -1900,7 +2138,11 @@ void QQmlImportDatabase::setImportPathList(const QStringList &paths)
     if (qmlImportTrace())
         qDebug().nospace() << "QQmlImportDatabase::setImportPathList: " << paths;
 
-    fileImportPath = paths;
+    {
+        QMutexLocker locker(&persistentCacheMutex);
+        fileImportPath = paths;
+        persistentCache.reset();
+    }
 
     // Our existing cached paths may have been invalidated
     clearDirCache();
@@ -2039,6 +2281,8 @@ bool QQmlImportDatabase::importDynamicPlugin(const QString &filePath, const QStr
                                              const QString &typeNamespace, int vmaj, QList<QQmlError> *errors)
 {
 #if QT_CONFIG(library)
+    QQmlStartupTrace::Range traceRange(QQmlStartupTrace::LoadPlugin, filePath);
+    QQmlCompilingProfiler prof(QQmlEnginePrivate::get(engine)->profiler, filePath);
     QFileInfo fileInfo(filePath);
     const QString absoluteFilePath = fileInfo.absoluteFilePath();
 
@@ -42,6 +42,8 @@
 
 #include <QtCore/qurl.h>
 #include <QtCore/qcoreapplication.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qset.h>
 #include <QtCore/qstringlist.h>
 #include <private/qqmldirparser_p.h>
@@ -69,6 +71,7 @@ class QQmlImportsPrivate;
 class QQmlImportDatabase;
 class QQmlTypeLoader;
 class QQmlTypeLoaderQmldirContent;
+class QQmlImportResolutionCache;
 
 struct QQmlImportInstance
 {
@@ -218,6 +221,7 @@ private:
     bool registerPluginTypes(QObject *instance, const QString &basePath,
                           const QString &uri, const QString &typeNamespace, int vmaj, QList<QQmlError> *errors);
     void clearDirCache();
+    QSharedPointer<QQmlImportResolutionCache> resolutionCache();
 
     struct QmldirCache {
         int versionMajor;
@@ -230,6 +234,13 @@ private:
     // Used in QQmlImportsPrivate::locateQmldir()
     QStringHash<QmldirCache *> qmldirCache;
 
+    // Locations of qmldir files and plugins found by previous runs, see QML_IMPORT_CACHE.
+    // Created on first use for the current import and plugin path lists, and shared with
+    // the lookups using it.
+    const bool persistentCacheEnabled;
+    QMutex persistentCacheMutex;
+    QSharedPointer<QQmlImportResolutionCache> persistentCache;
+
     // XXX thread
     QStringList filePluginPath;
     QStringList fileImportPath;
@@ -252,21 +252,44 @@ void QQmlJavaScriptExpression::evaluate(QV4::CallData *callData, bool *isUndefin
     ep->propertyCapture = lastPropertyCapture;
 }
 
+// The guards of the previous evaluation are recycled in the order they were captured in, so
+// for an unchanged dependency list the match is always the first guard. When a branch reads
+// something new or skips a read, look a few guards ahead instead of dropping everything in
+// between: those are usually captured again right after, and reconnecting them is what makes
+// a changing path expensive. Guards that are never matched are deleted after the evaluation.
+typedef QFieldList<QQmlJavaScriptExpressionGuard, &QQmlJavaScriptExpressionGuard::next> GuardList;
+
+template<typename Matches>
+static QQmlJavaScriptExpressionGuard *takeMatchingGuard(GuardList &guards, Matches matches)
+{
+    static const int maxLookAhead = 8;
+
+    QQmlJavaScriptExpressionGuard *g = guards.first();
+    for (int i = 0; g && i <= maxLookAhead; ++i, g = GuardList::next(g)) {
+        if (!matches(g))
+            continue;
+
+        GuardList skipped;
+        while (guards.first() != g)
+            skipped.append(guards.takeFirst());
+        guards.takeFirst();
+        guards.prepend(skipped);
+        return g;
+    }
+    return 0;
+}
+
 void QQmlPropertyCapture::captureProperty(QQmlNotifier *n, Duration duration)
 {
     if (watcher->wasDeleted())
         return;
 
     Q_ASSERT(expression);
-    // Try and find a matching guard
-    while (!guards.isEmpty() && !guards.first()->isConnected(n))
-        guards.takeFirst()->Delete();
-
-    QQmlJavaScriptExpressionGuard *g = 0;
-    if (!guards.isEmpty()) {
-        g = guards.takeFirst();
+    QQmlJavaScriptExpressionGuard *g = takeMatchingGuard(guards, [n](QQmlJavaScriptExpressionGuard *guard) {
+        return guard->isConnected(n);
+    });
+    if (g) {
         g->cancelNotify();
-        Q_ASSERT(g->isConnected(n));
     } else {
         g = QQmlJavaScriptExpressionGuard::New(expression, engine);
         g->connect(n);
@@ -307,15 +330,11 @@ void QQmlPropertyCapture::captureProperty(QObject *o, int c, int n, Duration dur
         errorString->append(error);
     } else {
 
-        // Try and find a matching guard
-        while (!guards.isEmpty() && !guards.first()->isConnected(o, n))
-            guards.takeFirst()->Delete();
-
-        QQmlJavaScriptExpressionGuard *g = 0;
-        if (!guards.isEmpty()) {
-            g = guards.takeFirst();
+        QQmlJavaScriptExpressionGuard *g = takeMatchingGuard(guards, [o, n](QQmlJavaScriptExpressionGuard *guard) {
+            return guard->isConnected(o, n);
+        });
+        if (g) {
             g->cancelNotify();
-            Q_ASSERT(g->isConnected(o, n));
         } else {
             g = QQmlJavaScriptExpressionGuard::New(expression, engine);
             g->connect(o, n, engine);
@@ -161,6 +161,12 @@ protected:
 
     void setupFunction(QV4::ExecutionContext *qmlContext, QV4::Function *f);
 
+    bool permanentDependenciesRegistered() const { return m_permanentDependenciesRegistered; }
+    void setPermanentDependenciesRegistered() { m_permanentDependenciesRegistered = true; }
+
+    bool isUpdatePending() const { return m_updatePending; }
+    void setUpdatePending(bool v) { m_updatePending = v; }
+
 private:
     friend class QQmlContextData;
     friend class QQmlPropertyCapture;
@@ -179,6 +185,7 @@ private:
     QQmlJavaScriptExpression **m_prevExpression;
     QQmlJavaScriptExpression  *m_nextExpression;
     bool m_permanentDependenciesRegistered = false;
+    bool m_updatePending = false; // queued for a deferred update, see QQmlBinding
 
     QV4::PersistentValue m_qmlScope;
     QQmlRefPointer<QV4::CompiledData::CompilationUnit> m_compilationUnit;
@@ -50,6 +50,8 @@
 #include <QtCore/qmetaobject.h>
 #include <QtCore/qbitarray.h>
 #include <QtCore/qreadwritelock.h>
+#include <QtCore/qsharedpointer.h>
+#include <QtCore/qthreadstorage.h>
 #include <QtCore/private/qmetaobject_p.h>
 
 #include <qmetatype.h>
@@ -65,6 +67,9 @@
 
 QT_BEGIN_NAMESPACE
 
+struct QQmlMetaTypeSnapshot;
+class QQmlTypeModulePrivate;
+
 struct QQmlMetaTypeData
 {
     QQmlMetaTypeData();
@@ -110,6 +115,37 @@ struct QQmlMetaTypeData
 
     QString typeRegistrationNamespace;
     QStringList typeRegistrationFailures;
+
+    // Bumped on every change to the tables above that lookups see through
+    // QQmlMetaTypeSnapshot, see QQmlMetaTypeLookup.
+    QAtomicInt generation;
+    QSharedPointer<const QQmlMetaTypeSnapshot> snapshot;
+    int lookupsSinceChange = 0; // made on the live tables, without a snapshot
+
+    void invalidateSnapshot();
+    QSharedPointer<const QQmlMetaTypeSnapshot> currentSnapshot();
+};
+
+// The lookup tables of the registry: either those of a snapshot or, with the lock held,
+// the live ones of QQmlMetaTypeData.
+struct QQmlMetaTypeTables
+{
+    struct Module {
+        const QStringHash<QList<QQmlType *> > *typeHash;
+        int minMinorVersion;
+        int maxMinorVersion;
+    };
+
+    const QList<QQmlType *> *types;
+    const QQmlMetaTypeData::Ids *idToType;
+    const QQmlMetaTypeData::Names *nameToType;
+    const QQmlMetaTypeData::Files *urlToType;
+    const QQmlMetaTypeData::Files *urlToNonFileImportType;
+    const QQmlMetaTypeData::MetaObjects *metaObjectToType;
+    const QQmlMetaTypeData::TypeModules *uriToModule;
+    const QHash<const QQmlTypeModule *, Module> *modules; // 0 for the live tables
+
+    bool module(const QQmlTypeModule *m, Module *result) const;
 };
 
 class QQmlTypeModulePrivate
@@ -128,12 +164,61 @@ public:
 
     void add(QQmlType *);
 
-    QStringHash<QList<QQmlType *> > typeHash;
+    typedef QStringHash<QList<QQmlType *> > TypeHash;
+    TypeHash typeHash;
+    QSharedPointer<const TypeHash> publishedTypeHash; // copy of typeHash for snapshots, reset by add()
     QList<QQmlType *> types;
 };
 
+// A copy of the registry's lookup tables that does not change after it has been created.
+// The containers share their data with QQmlMetaTypeData, but the first registration after
+// creating a snapshot detaches them, so snapshots are only created once the registry is
+// mostly read from, see QQmlMetaTypeLookup.
+struct QQmlMetaTypeSnapshot
+{
+    int generation;
+    QList<QQmlType *> types;
+    QQmlMetaTypeData::Ids idToType;
+    QQmlMetaTypeData::Names nameToType;
+    QQmlMetaTypeData::Files urlToType;
+    QQmlMetaTypeData::Files urlToNonFileImportType;
+    QQmlMetaTypeData::MetaObjects metaObjectToType;
+    QQmlMetaTypeData::TypeModules uriToModule;
+    QHash<const QQmlTypeModule *, QQmlMetaTypeTables::Module> modules;
+    QVector<QSharedPointer<const QQmlTypeModulePrivate::TypeHash> > typeHashes; // owns modules' hashes
+
+    QQmlMetaTypeTables tables;
+};
+
+/*
+    Gives access to the registry's lookup tables for the lifetime of the object.
+
+    Every thread keeps the snapshot it used last, and uses it without locking as long as
+    nothing has been registered since. Otherwise the lookup takes the lock and reads the live
+    tables. A new snapshot costs about a copy of the registry, so it is only created once
+    there have been as many lookups since the last registration as there are types. Sequences
+    of registrations and lookups, like the composite type registrations of QQmlImports,
+    therefore do not copy the registry each time, and lookups from the type loader thread, the
+    GUI thread and worker engines do not contend once registration has settled.
+*/
+class QQmlMetaTypeLookup
+{
+public:
+    QQmlMetaTypeLookup();
+    ~QQmlMetaTypeLookup();
+
+    const QQmlMetaTypeTables *operator->() const { return m_tables; }
+
+private:
+    Q_DISABLE_COPY(QQmlMetaTypeLookup)
+    const QQmlMetaTypeTables *m_tables;
+    QQmlMetaTypeTables m_liveTables;
+    QMutex *m_lockedMutex;
+};
+
 Q_GLOBAL_STATIC(QQmlMetaTypeData, metaTypeData)
 Q_GLOBAL_STATIC_WITH_ARGS(QMutex, metaTypeDataLock, (QMutex::Recursive))
+Q_GLOBAL_STATIC(QThreadStorage<QSharedPointer<const QQmlMetaTypeSnapshot> >, threadMetaTypeSnapshot)
 
 static uint qHash(const QQmlMetaTypeData::VersionedUri &v)
 {
@@ -153,6 +238,100 @@ QQmlMetaTypeData::~QQmlMetaTypeData()
         delete *i;
 }
 
+// NOTE: caller must hold a QMutexLocker on "data"
+void QQmlMetaTypeData::invalidateSnapshot()
+{
+    snapshot.reset();
+    lookupsSinceChange = 0;
+    generation.ref();
+}
+
+// NOTE: caller must hold a QMutexLocker on "data"
+QSharedPointer<const QQmlMetaTypeSnapshot> QQmlMetaTypeData::currentSnapshot()
+{
+    if (snapshot)
+        return snapshot;
+
+    QQmlMetaTypeSnapshot *s = new QQmlMetaTypeSnapshot;
+    s->generation = generation.load();
+    s->types = types;
+    s->idToType = idToType;
+    s->nameToType = nameToType;
+    s->urlToType = urlToType;
+    s->urlToNonFileImportType = urlToNonFileImportType;
+    s->metaObjectToType = metaObjectToType;
+    s->uriToModule = uriToModule;
+    s->typeHashes.reserve(uriToModule.count());
+    for (TypeModules::const_iterator i = uriToModule.constBegin(), cend = uriToModule.constEnd(); i != cend; ++i) {
+        QQmlTypeModulePrivate *p = QQmlTypeModulePrivate::get(*i);
+        if (!p->publishedTypeHash)
+            p->publishedTypeHash.reset(new QQmlTypeModulePrivate::TypeHash(p->typeHash));
+        s->typeHashes.append(p->publishedTypeHash);
+        QQmlMetaTypeTables::Module module = { p->publishedTypeHash.data(), p->minMinorVersion, p->maxMinorVersion };
+        s->modules.insert(*i, module);
+    }
+
+    QQmlMetaTypeTables tables = { &s->types, &s->idToType, &s->nameToType, &s->urlToType,
+                                  &s->urlToNonFileImportType, &s->metaObjectToType,
+                                  &s->uriToModule, &s->modules };
+    s->tables = tables;
+
+    snapshot.reset(s);
+    return snapshot;
+}
+
+bool QQmlMetaTypeTables::module(const QQmlTypeModule *m, Module *result) const
+{
+    if (modules) {
+        QHash<const QQmlTypeModule *, Module>::const_iterator it = modules->constFind(m);
+        if (it == modules->cend())
+            return false;
+        *result = *it;
+        return true;
+    }
+
+    const QQmlTypeModulePrivate *p = QQmlTypeModulePrivate::get(const_cast<QQmlTypeModule *>(m));
+    result->typeHash = &p->typeHash;
+    result->minMinorVersion = p->minMinorVersion;
+    result->maxMinorVersion = p->maxMinorVersion;
+    return true;
+}
+
+QQmlMetaTypeLookup::QQmlMetaTypeLookup()
+    : m_tables(0), m_lockedMutex(0)
+{
+    QQmlMetaTypeData *data = metaTypeData();
+    QThreadStorage<QSharedPointer<const QQmlMetaTypeSnapshot> > *storage = threadMetaTypeSnapshot();
+    QSharedPointer<const QQmlMetaTypeSnapshot> *local = storage ? &storage->localData() : 0;
+    if (local && *local && (*local)->generation == data->generation.loadAcquire()) {
+        m_tables = &(*local)->tables;
+        return;
+    }
+
+    QMutex *lock = metaTypeDataLock();
+    lock->lock();
+    // While shutting down there is no thread local storage, keep using the live tables then.
+    if (local && (data->snapshot || ++data->lookupsSinceChange > data->types.count())) {
+        *local = data->currentSnapshot();
+        lock->unlock();
+        m_tables = &(*local)->tables;
+        return;
+    }
+
+    m_lockedMutex = lock;
+    QQmlMetaTypeTables tables = { &data->types, &data->idToType, &data->nameToType, &data->urlToType,
+                                  &data->urlToNonFileImportType, &data->metaObjectToType,
+                                  &data->uriToModule, 0 };
+    m_liveTables = tables;
+    m_tables = &m_liveTables;
+}
+
+QQmlMetaTypeLookup::~QQmlMetaTypeLookup()
+{
+    if (m_lockedMutex)
+        m_lockedMutex->unlock();
+}
+
 class QQmlTypePrivate
 {
 public:
@@ -1226,6 +1405,8 @@ void QQmlTypeModulePrivate::add(QQmlType *type)
     minMinorVersion = qMin(minMinorVersion, type->minorVersion());
     maxMinorVersion = qMax(maxMinorVersion, type->minorVersion());
 
+    publishedTypeHash.reset();
+
     QList<QQmlType *> &list = typeHash[type->elementName()];
     for (int ii = 0; ii < list.count(); ++ii) {
         if (list.at(ii)->minorVersion() < type->minorVersion()) {
@@ -1236,11 +1417,15 @@ void QQmlTypeModulePrivate::add(QQmlType *type)
     list.append(type);
 }
 
-QQmlType *QQmlTypeModule::type(const QHashedStringRef &name, int minor) const
+template<typename Key>
+static QQmlType *moduleType(const QQmlTypeModule *module, const Key &name, int minor)
 {
-    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeLookup data;
+    QQmlMetaTypeTables::Module m;
+    if (!data->module(module, &m))
+        return 0;
 
-    QList<QQmlType *> *types = d->typeHash.value(name);
+    QList<QQmlType *> *types = m.typeHash->value(name);
     if (!types) return 0;
 
     for (int ii = 0; ii < types->count(); ++ii)
@@ -1250,18 +1435,14 @@ QQmlType *QQmlTypeModule::type(const QHashedStringRef &name, int minor) const
     return 0;
 }
 
-QQmlType *QQmlTypeModule::type(const QV4::String *name, int minor) const
+QQmlType *QQmlTypeModule::type(const QHashedStringRef &name, int minor) const
 {
-    QMutexLocker lock(metaTypeDataLock());
-
-    QList<QQmlType *> *types = d->typeHash.value(name);
-    if (!types) return 0;
-
-    for (int ii = 0; ii < types->count(); ++ii)
-        if (types->at(ii)->minorVersion() <= minor)
-            return types->at(ii);
+    return moduleType(this, name, minor);
+}
 
-    return 0;
+QQmlType *QQmlTypeModule::type(const QV4::String *name, int minor) const
+{
+    return moduleType(this, name, minor);
 }
 
 QList<QQmlType*> QQmlTypeModule::singletonTypes(int minor) const
@@ -1343,6 +1524,7 @@ void qmlClearTypeRegistrations() // Declared in qqml.h
     data->urlToNonFileImportType.clear();
     data->metaObjectToType.clear();
     data->uriToModule.clear();
+    data->invalidateSnapshot();
 
     QQmlEnginePrivate::baseModulesUninitialized = true; //So the engine re-registers its types
 #if QT_CONFIG(library)
@@ -1385,6 +1567,7 @@ int registerInterface(const QQmlPrivate::RegisterInterface &interface)
         data->lists.resize(interface.listId + 16);
     data->interfaces.setBit(interface.typeId, true);
     data->lists.setBit(interface.listId, true);
+    data->invalidateSnapshot();
 
     return index;
 }
@@ -1515,6 +1698,7 @@ int registerType(const QQmlPrivate::RegisterType &type)
     addTypeToData(dtype, data);
     if (!type.typeId)
         data->idToType.insert(dtype->typeId(), dtype);
+    data->invalidateSnapshot();
 
     return index;
 }
@@ -1533,6 +1717,7 @@ int registerSingletonType(const QQmlPrivate::RegisterSingletonType &type)
 
     data->types.append(dtype);
     addTypeToData(dtype, data);
+    data->invalidateSnapshot();
 
     return index;
 }
@@ -1558,6 +1743,7 @@ int registerCompositeSingletonType(const QQmlPrivate::RegisterCompositeSingleton
 
     QQmlMetaTypeData::Files *files = fileImport ? &(data->urlToType) : &(data->urlToNonFileImportType);
     files->insertMulti(type.url, dtype);
+    data->invalidateSnapshot();
 
     return index;
 }
@@ -1582,6 +1768,7 @@ int registerCompositeType(const QQmlPrivate::RegisterCompositeType &type)
 
     QQmlMetaTypeData::Files *files = fileImport ? &(data->urlToType) : &(data->urlToNonFileImportType);
     files->insertMulti(type.url, dtype);
+    data->invalidateSnapshot();
 
     return index;
 }
@@ -1649,6 +1836,7 @@ void qmlRegisterModule(const char *uri, int versionMajor, int versionMinor)
     QQmlTypeModulePrivate *p = QQmlTypeModulePrivate::get(module);
     p->minMinorVersion = qMin(p->minMinorVersion, versionMinor);
     p->maxMinorVersion = qMax(p->maxMinorVersion, versionMinor);
+    data->invalidateSnapshot();
 }
 
 bool QQmlMetaType::namespaceContainsRegistrations(const QString &uri, int majorVersion)
@@ -1696,11 +1884,10 @@ QMutex *QQmlMetaType::typeRegistrationLock()
 */
 bool QQmlMetaType::isAnyModule(const QString &uri)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeLookup data;
 
-    for (QQmlMetaTypeData::TypeModules::ConstIterator iter = data->uriToModule.cbegin();
-         iter != data->uriToModule.cend(); ++iter) {
+    for (QQmlMetaTypeData::TypeModules::ConstIterator iter = data->uriToModule->cbegin();
+         iter != data->uriToModule->cend(); ++iter) {
         if ((*iter)->module() == uri)
             return true;
     }
@@ -1734,24 +1921,22 @@ bool QQmlMetaType::isLockedModule(const QString &uri, int majVersion)
 bool QQmlMetaType::isModule(const QString &module, int versionMajor, int versionMinor)
 {
     Q_ASSERT(versionMajor >= 0 && versionMinor >= 0);
-    QMutexLocker lock(metaTypeDataLock());
-
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeLookup data;
 
     // first, check Types
     QQmlTypeModule *tm =
-        data->uriToModule.value(QQmlMetaTypeData::VersionedUri(module, versionMajor));
-    if (tm && tm->minimumMinorVersion() <= versionMinor && tm->maximumMinorVersion() >= versionMinor)
-        return true;
+        data->uriToModule->value(QQmlMetaTypeData::VersionedUri(module, versionMajor));
+    QQmlMetaTypeTables::Module m;
+    if (!tm || !data->module(tm, &m))
+        return false;
 
-    return false;
+    return m.minMinorVersion <= versionMinor && m.maxMinorVersion >= versionMinor;
 }
 
 QQmlTypeModule *QQmlMetaType::typeModule(const QString &uri, int majorVersion)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
-    return data->uriToModule.value(QQmlMetaTypeData::VersionedUri(uri, majorVersion));
+    QQmlMetaTypeLookup data;
+    return data->uriToModule->value(QQmlMetaTypeData::VersionedUri(uri, majorVersion));
 }
 
 QList<QQmlPrivate::AutoParentFunction> QQmlMetaType::parentFunctions()
@@ -1788,9 +1973,8 @@ bool QQmlMetaType::isQObject(int userType)
  */
 int QQmlMetaType::listType(int id)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
-    QQmlType *type = data->idToType.value(id);
+    QQmlMetaTypeLookup data;
+    QQmlType *type = data->idToType->value(id);
     if (type && type->qListTypeId() == id)
         return type->typeId();
     else
@@ -1973,11 +2157,10 @@ QQmlType *QQmlMetaType::qmlType(const QString &qualifiedName, int version_major,
 QQmlType *QQmlMetaType::qmlType(const QHashedStringRef &name, const QHashedStringRef &module, int version_major, int version_minor)
 {
     Q_ASSERT(version_major >= 0 && version_minor >= 0);
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeLookup data;
 
-    QQmlMetaTypeData::Names::ConstIterator it = data->nameToType.constFind(name);
-    while (it != data->nameToType.cend() && it.key() == name) {
+    QQmlMetaTypeData::Names::ConstIterator it = data->nameToType->constFind(name);
+    while (it != data->nameToType->cend() && it.key() == name) {
         // XXX version_major<0 just a kludge for QQmlPropertyPrivate::initProperty
         if (version_major < 0 || module.isEmpty() || (*it)->availableInVersion(module, version_major,version_minor))
             return (*it);
@@ -1993,10 +2176,9 @@ QQmlType *QQmlMetaType::qmlType(const QHashedStringRef &name, const QHashedStrin
 */
 QQmlType *QQmlMetaType::qmlType(const QMetaObject *metaObject)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeLookup data;
 
-    return data->metaObjectToType.value(metaObject);
+    return data->metaObjectToType->value(metaObject);
 }
 
 /*!
@@ -2007,11 +2189,10 @@ QQmlType *QQmlMetaType::qmlType(const QMetaObject *metaObject)
 QQmlType *QQmlMetaType::qmlType(const QMetaObject *metaObject, const QHashedStringRef &module, int version_major, int version_minor)
 {
     Q_ASSERT(version_major >= 0 && version_minor >= 0);
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeLookup data;
 
-    QQmlMetaTypeData::MetaObjects::const_iterator it = data->metaObjectToType.constFind(metaObject);
-    while (it != data->metaObjectToType.cend() && it.key() == metaObject) {
+    QQmlMetaTypeData::MetaObjects::const_iterator it = data->metaObjectToType->constFind(metaObject);
+    while (it != data->metaObjectToType->cend() && it.key() == metaObject) {
         QQmlType *t = *it;
         if (version_major < 0 || module.isEmpty() || t->availableInVersion(module, version_major,version_minor))
             return t;
@@ -2027,10 +2208,9 @@ QQmlType *QQmlMetaType::qmlType(const QMetaObject *metaObject, const QHashedStri
 */
 QQmlType *QQmlMetaType::qmlType(int userType)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeLookup data;
 
-    QQmlType *type = data->idToType.value(userType);
+    QQmlType *type = data->idToType->value(userType);
     if (type && type->typeId() == userType)
         return type;
     else
@@ -2045,12 +2225,11 @@ QQmlType *QQmlMetaType::qmlType(int userType)
 */
 QQmlType *QQmlMetaType::qmlType(const QUrl &url, bool includeNonFileImports /* = false */)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeLookup data;
 
-    QQmlType *type = data->urlToType.value(url);
+    QQmlType *type = data->urlToType->value(url);
     if (!type && includeNonFileImports)
-        type = data->urlToNonFileImportType.value(url);
+        type = data->urlToNonFileImportType->value(url);
 
     if (type && type->sourceUrl() == url)
         return type;
@@ -2065,12 +2244,11 @@ QQmlType *QQmlMetaType::qmlType(const QUrl &url, bool includeNonFileImports /* =
 */
 QQmlType *QQmlMetaType::qmlTypeFromIndex(int idx)
 {
-    QMutexLocker lock(metaTypeDataLock());
-    QQmlMetaTypeData *data = metaTypeData();
+    QQmlMetaTypeLookup data;
 
-    if (idx < 0 || idx >= data->types.count())
+    if (idx < 0 || idx >= data->types->count())
             return 0;
-    return data->types.at(idx);
+    return data->types->at(idx);
 }
 
 /*!
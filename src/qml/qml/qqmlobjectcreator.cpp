@@ -55,6 +55,7 @@
 #include <private/qqmlvaluetypeproxybinding_p.h>
 #include <private/qqmldebugconnector_p.h>
 #include <private/qqmldebugserviceinterfaces_p.h>
+#include <private/qqmlstartuptrace_p.h>
 
 QT_USE_NAMESPACE
 
@@ -159,6 +160,8 @@ QObject *QQmlObjectCreator::create(int subComponentIndex, QObject *parent, QQmlI
     Q_ASSERT(phase == Startup);
     phase = CreatingObjects;
 
+    QQmlStartupTrace::Range traceRange(QQmlStartupTrace::Create, compilationUnit->url());
+
     int objectToCreate;
 
     if (subComponentIndex == -1) {
@@ -802,7 +805,7 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *property, con
         QQmlPropertyPrivate::removeBinding(_bindingTarget, QQmlPropertyIndex(property->coreIndex()));
 
     if (binding->type == QV4::CompiledData::Binding::Type_Script) {
-        QV4::Function *runtimeFunction = compilationUnit->runtimeFunctions[binding->value.compiledScriptIndex];
+        QV4::Function *runtimeFunction = compilationUnit->runtimeFunction(binding->value.compiledScriptIndex);
 
         QV4::Scope scope(v4);
         QV4::Scoped<QV4::QmlContext> qmlContext(scope, currentQmlContext());
@@ -827,7 +830,14 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *property, con
                 prop = _valueTypeProperty;
                 subprop = property;
             }
-            qmlBinding = QQmlBinding::create(prop, runtimeFunction, _scopeObject, context, qmlContext);
+            if (binding->flags & QV4::CompiledData::Binding::IsPropertyReadBinding
+                && !_valueTypeProperty && !property->isAlias()) {
+                qmlBinding = QQmlBinding::createPropertyRead(runtimeFunction, _scopeObject, context, qmlContext,
+                                                             binding->value.propertyRead.sourceIdIndex,
+                                                             binding->value.propertyRead.sourcePropertyIndex);
+            } else {
+                qmlBinding = QQmlBinding::create(prop, runtimeFunction, _scopeObject, context, qmlContext);
+            }
             qmlBinding->setTarget(_bindingTarget, *prop, subprop);
 
             sharedState->allCreatedBindings.push(QQmlAbstractBinding::Ptr(qmlBinding));
@@ -998,7 +1008,7 @@ void QQmlObjectCreator::setupFunctions()
 
     const QV4::CompiledData::LEUInt32 *functionIdx = _compiledObject->functionOffsetTable();
     for (quint32 i = 0; i < _compiledObject->nFunctions; ++i, ++functionIdx) {
-        QV4::Function *runtimeFunction = compilationUnit->runtimeFunctions[*functionIdx];
+        QV4::Function *runtimeFunction = compilationUnit->runtimeFunction(*functionIdx);
         const QString name = runtimeFunction->name()->toQString();
 
         QQmlPropertyData *property = _propertyCache->property(name, _qobject, context);
@@ -1207,6 +1217,8 @@ QQmlContextData *QQmlObjectCreator::finalize(QQmlInstantiationInterrupt &interru
     Q_ASSERT(phase == ObjectsCreated || phase == Finalizing);
     phase = Finalizing;
 
+    QQmlStartupTrace::Range traceRange(QQmlStartupTrace::Finalize, compilationUnit->url());
+
     QQmlObjectCreatorRecursionWatcher watcher(this);
     ActiveOCRestorer ocRestorer(this, QQmlEnginePrivate::get(engine));
 
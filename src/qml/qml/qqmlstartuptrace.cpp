@@ -0,0 +1,254 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qqmlstartuptrace_p.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+QBasicAtomicInt QQmlStartupTrace::enabled = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+namespace {
+
+struct StartupTraceEvent
+{
+    enum { DiskCacheHit = QQmlStartupTrace::MaximumPhase, DiskCacheMiss };
+
+    int type; // QQmlStartupTrace::Phase or one of the disk cache events
+    QString detail;
+    QString reason;
+    qint64 startTime;
+    qint64 endTime;
+    quintptr threadId;
+};
+
+struct StartupTraceData
+{
+    QMutex mutex;
+    QElapsedTimer timer;
+    QString outputFileName;
+    QVector<StartupTraceEvent> events;
+
+    void append(const StartupTraceEvent &event)
+    {
+        QMutexLocker locker(&mutex);
+        events.append(event);
+    }
+};
+
+}
+
+Q_GLOBAL_STATIC(StartupTraceData, startupTraceData)
+
+static const char *phaseName(int type)
+{
+    switch (type) {
+    case QQmlStartupTrace::ResolveQmldir: return "ResolveQmldir";
+    case QQmlStartupTrace::LoadPlugin: return "LoadPlugin";
+    case QQmlStartupTrace::Parse: return "Parse";
+    case QQmlStartupTrace::Compile: return "Compile";
+    case QQmlStartupTrace::Create: return "Create";
+    case QQmlStartupTrace::Finalize: return "Finalize";
+    case StartupTraceEvent::DiskCacheHit: return "DiskCacheHit";
+    case StartupTraceEvent::DiskCacheMiss: return "DiskCacheMiss";
+    default: break;
+    }
+    return "Unknown";
+}
+
+static QLatin1String detailKey(int type)
+{
+    switch (type) {
+    case QQmlStartupTrace::ResolveQmldir: return QLatin1String("module");
+    case QQmlStartupTrace::LoadPlugin: return QLatin1String("plugin");
+    default: break;
+    }
+    return QLatin1String("url");
+}
+
+void QQmlStartupTrace::start(const QString &outputFileName)
+{
+    StartupTraceData *data = startupTraceData();
+    {
+        QMutexLocker locker(&data->mutex);
+        if (enabled.load())
+            return;
+        data->outputFileName = outputFileName;
+        data->events.clear();
+        data->timer.start();
+    }
+    enabled.store(1);
+
+    static bool postRoutineAdded = false;
+    if (!postRoutineAdded && !outputFileName.isEmpty()) {
+        qAddPostRoutine(&QQmlStartupTrace::stop);
+        postRoutineAdded = true;
+    }
+}
+
+/*
+    Stops recording and writes the trace to the file given to start(), if any.
+*/
+void QQmlStartupTrace::stop()
+{
+    if (!enabled.load() || startupTraceData.isDestroyed())
+        return;
+    enabled.store(0);
+
+    StartupTraceData *data = startupTraceData();
+    const QString outputFileName = data->outputFileName;
+    if (outputFileName.isEmpty())
+        return;
+
+    QFile file(outputFileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            || file.write(toChromeTraceJson()) == -1) {
+        qWarning("QQmlStartupTrace: Cannot write %s: %s", qPrintable(outputFileName),
+                 qPrintable(file.errorString()));
+    }
+}
+
+qint64 QQmlStartupTrace::timestamp()
+{
+    return startupTraceData()->timer.nsecsElapsed();
+}
+
+void QQmlStartupTrace::addRange(Phase phase, const QString &detail, qint64 startTime, qint64 endTime)
+{
+    const StartupTraceEvent event = { phase, detail, QString(), startTime, endTime,
+                                      quintptr(QThread::currentThreadId()) };
+    startupTraceData()->append(event);
+}
+
+void QQmlStartupTrace::addDiskCacheHit(const QUrl &url)
+{
+    if (!isEnabled())
+        return;
+    const qint64 now = timestamp();
+    const StartupTraceEvent event = { StartupTraceEvent::DiskCacheHit, url.toString(), QString(), now, now,
+                                      quintptr(QThread::currentThreadId()) };
+    startupTraceData()->append(event);
+}
+
+void QQmlStartupTrace::addDiskCacheMiss(const QUrl &url, const QString &reason)
+{
+    if (!isEnabled())
+        return;
+    const qint64 now = timestamp();
+    const StartupTraceEvent event = { StartupTraceEvent::DiskCacheMiss, url.toString(), reason, now, now,
+                                      quintptr(QThread::currentThreadId()) };
+    startupTraceData()->append(event);
+}
+
+/*
+    Returns the events recorded so far in the JSON object format understood by
+    chrome://tracing. Ranges are complete ("X") events and disk cache lookups are
+    instant ("i") events. The number of cache hits and misses per reason is summarized
+    in "otherData".
+*/
+QByteArray QQmlStartupTrace::toChromeTraceJson()
+{
+    StartupTraceData *data = startupTraceData();
+    QMutexLocker locker(&data->mutex);
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+    int cacheHits = 0;
+    QHash<QString, int> cacheMisses;
+
+    for (const StartupTraceEvent &event : qAsConst(data->events)) {
+        QJsonObject args;
+        args.insert(detailKey(event.type), event.detail);
+
+        QJsonObject traceEvent;
+        traceEvent.insert(QLatin1String("name"), QLatin1String(phaseName(event.type)));
+        traceEvent.insert(QLatin1String("pid"), pid);
+        traceEvent.insert(QLatin1String("tid"), qint64(event.threadId));
+        traceEvent.insert(QLatin1String("ts"), event.startTime / 1000.0);
+
+        if (event.type < MaximumPhase) {
+            traceEvent.insert(QLatin1String("cat"), QLatin1String("qml"));
+            traceEvent.insert(QLatin1String("ph"), QLatin1String("X"));
+            traceEvent.insert(QLatin1String("dur"), (event.endTime - event.startTime) / 1000.0);
+        } else {
+            traceEvent.insert(QLatin1String("cat"), QLatin1String("qml.diskcache"));
+            traceEvent.insert(QLatin1String("ph"), QLatin1String("i"));
+            traceEvent.insert(QLatin1String("s"), QLatin1String("t"));
+            if (event.type == StartupTraceEvent::DiskCacheHit) {
+                ++cacheHits;
+            } else {
+                args.insert(QLatin1String("reason"), event.reason);
+                ++cacheMisses[event.reason];
+            }
+        }
+
+        traceEvent.insert(QLatin1String("args"), args);
+        traceEvents.append(traceEvent);
+    }
+
+    QJsonObject missReasons;
+    int cacheMissCount = 0;
+    for (QHash<QString, int>::ConstIterator it = cacheMisses.constBegin(); it != cacheMisses.constEnd(); ++it) {
+        missReasons.insert(it.key(), *it);
+        cacheMissCount += *it;
+    }
+
+    QJsonObject otherData;
+    otherData.insert(QLatin1String("diskCacheHits"), cacheHits);
+    otherData.insert(QLatin1String("diskCacheMisses"), cacheMissCount);
+    otherData.insert(QLatin1String("diskCacheMissReasons"), missReasons);
+
+    QJsonObject root;
+    root.insert(QLatin1String("traceEvents"), traceEvents);
+    root.insert(QLatin1String("displayTimeUnit"), QLatin1String("ms"));
+    root.insert(QLatin1String("otherData"), otherData);
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+QT_END_NAMESPACE
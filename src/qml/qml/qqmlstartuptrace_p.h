@@ -0,0 +1,134 @@
+/****************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QQMLSTARTUPTRACE_P_H
+#define QQMLSTARTUPTRACE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtqmlglobal_p.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qurl.h>
+
+QT_BEGIN_NAMESPACE
+
+// Opt-in record of where the time goes while an application loads its QML, enabled
+// by setting QML_STARTUP_TRACE to the name of a file. The events are written as
+// Chrome trace JSON when the application exits.
+// The same phases are visible to qmlprofiler without this file: ResolveQmldir and
+// LoadPlugin are reported as Compiling ranges, Parse and Compile fall into the
+// existing Compiling ranges of the type loader, Create and Finalize into the
+// Creating ranges. Only the disk cache hits and misses are specific to this trace.
+class Q_QML_PRIVATE_EXPORT QQmlStartupTrace
+{
+public:
+    enum Phase {
+        ResolveQmldir,
+        LoadPlugin,
+        Parse,
+        Compile,
+        Create,
+        Finalize,
+
+        MaximumPhase
+    };
+
+    static bool isEnabled() { return enabled.load(); }
+
+    static void start(const QString &outputFileName);
+    static void stop();
+
+    static qint64 timestamp();
+    static void addRange(Phase phase, const QString &detail, qint64 startTime, qint64 endTime);
+    static void addDiskCacheHit(const QUrl &url);
+    static void addDiskCacheMiss(const QUrl &url, const QString &reason);
+
+    static QByteArray toChromeTraceJson();
+
+    class Range
+    {
+    public:
+        Range(Phase phase, const QString &detail)
+            : m_phase(phase), m_startTime(-1)
+        {
+            if (Q_UNLIKELY(isEnabled())) {
+                m_detail = detail;
+                m_startTime = timestamp();
+            }
+        }
+
+        Range(Phase phase, const QUrl &url)
+            : m_phase(phase), m_startTime(-1)
+        {
+            if (Q_UNLIKELY(isEnabled())) {
+                m_detail = url.toString();
+                m_startTime = timestamp();
+            }
+        }
+
+        ~Range()
+        {
+            if (Q_UNLIKELY(m_startTime >= 0))
+                addRange(m_phase, m_detail, m_startTime, timestamp());
+        }
+
+    private:
+        Q_DISABLE_COPY(Range)
+        Phase m_phase;
+        qint64 m_startTime;
+        QString m_detail;
+    };
+
+private:
+    static QBasicAtomicInt enabled;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLSTARTUPTRACE_P_H
@@ -47,6 +47,7 @@
 #include <private/qqmlcomponent_p.h>
 #include <private/qqmlprofiler_p.h>
 #include <private/qqmlmemoryprofiler_p.h>
+#include <private/qqmlstartuptrace_p.h>
 #include <private/qqmltypecompiler_p.h>
 #include <private/qqmlpropertyvalidator_p.h>
 #include <private/qqmlpropertycachecreator_p.h>
@@ -58,6 +59,7 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qrunnable.h>
 #include <QtQml/qqmlfile.h>
 #include <QtCore/qdiriterator.h>
 #include <QtQml/qqmlcomponent.h>
@@ -102,6 +104,7 @@
 DEFINE_BOOL_CONFIG_OPTION(dumpErrors, QML_DUMP_ERRORS);
 DEFINE_BOOL_CONFIG_OPTION(disableDiskCache, QML_DISABLE_DISK_CACHE);
 DEFINE_BOOL_CONFIG_OPTION(forceDiskCache, QML_FORCE_DISK_CACHE);
+DEFINE_BOOL_CONFIG_OPTION(disableParallelParsing, QML_DISABLE_PARALLEL_PARSING);
 
 Q_DECLARE_LOGGING_CATEGORY(DBG_DISK_CACHE)
 Q_LOGGING_CATEGORY(DBG_DISK_CACHE, "qt.qml.diskcache")
@@ -160,6 +163,7 @@ public:
     void callCompleted(QQmlDataBlob *b);
     void callDownloadProgressChanged(QQmlDataBlob *b, qreal p);
     void initializeEngine(QQmlExtensionInterface *, const char *);
+    void parsingDone(QQmlTypeData *b);
 
 protected:
     void shutdownThread() override;
@@ -168,6 +172,7 @@ private:
     void loadThread(QQmlDataBlob *b);
     void loadWithStaticDataThread(QQmlDataBlob *b, const QByteArray &);
     void loadWithCachedUnitThread(QQmlDataBlob *b, const QQmlPrivate::CachedQmlUnit *unit);
+    void parsingDoneThread(QQmlTypeData *b);
     void callCompletedMain(QQmlDataBlob *b);
     void callDownloadProgressChangedMain(QQmlDataBlob *b, qreal p);
     void initializeEngineMain(QQmlExtensionInterface *iface, const char *uri);
@@ -254,7 +259,7 @@ Create a new QQmlDataBlob for \a url and of the provided \a type.
 */
 QQmlDataBlob::QQmlDataBlob(const QUrl &url, Type type, QQmlTypeLoader *manager)
 : m_typeLoader(manager), m_type(type), m_url(url), m_finalUrl(url), m_redirectCount(0),
-  m_inCallback(false), m_isDone(false)
+  m_inCallback(false), m_isDone(false), m_isParsing(false)
 {
     //Set here because we need to get the engine from the manager
     if (m_typeLoader->engine() && m_typeLoader->engine()->urlInterceptor())
@@ -860,6 +865,12 @@ void QQmlTypeLoaderThread::initializeEngine(QQmlExtensionInterface *iface,
     callMethodInMain(&This::initializeEngineMain, iface, uri);
 }
 
+void QQmlTypeLoaderThread::parsingDone(QQmlTypeData *b)
+{
+    // The blob was referenced when it was handed to the parser pool.
+    postMethodToThread(&This::parsingDoneThread, b);
+}
+
 void QQmlTypeLoaderThread::shutdownThread()
 {
 #if QT_CONFIG(qml_network)
@@ -888,6 +899,12 @@ void QQmlTypeLoaderThread::loadWithCachedUnitThread(QQmlDataBlob *b, const QQmlP
     b->release();
 }
 
+void QQmlTypeLoaderThread::parsingDoneThread(QQmlTypeData *b)
+{
+    m_loader->parsingDoneThread(b);
+    b->release();
+}
+
 void QQmlTypeLoaderThread::callCompletedMain(QQmlDataBlob *b)
 {
     QML_MEMORY_SCOPE_URL(b->url());
@@ -1043,6 +1060,9 @@ void QQmlTypeLoader::doLoad(const Loader &loader, QQmlDataBlob *blob, Mode mode)
         loader.loadAsync(this, blob);
         lock();
     } else {
+        // The engine thread blocks until the loader thread is done with the blob, so the blob
+        // and its dependencies are parsed right away instead of on the parser pool.
+        m_synchronousLoads.ref();
         unlock();
         loader.load(this, blob);
         lock();
@@ -1053,13 +1073,25 @@ void QQmlTypeLoader::doLoad(const Loader &loader, QQmlDataBlob *blob, Mode mode)
             Q_ASSERT(mode == Synchronous);
             while (!blob->isCompleteOrError()) {
                 unlock();
-                m_thread->waitForNextMessage();
+                waitForLoaderThread();
                 lock();
             }
         }
+        m_synchronousLoads.deref();
     }
 }
 
+/*!
+Waits for the next message from the loader thread. The loader thread is idle while documents
+are parsed on the parser pool, so those are waited for first.
+*/
+void QQmlTypeLoader::waitForLoaderThread()
+{
+    Q_ASSERT(!m_thread->isThisThread());
+    m_parserPool.waitForDone();
+    m_thread->waitForNextMessage();
+}
+
 /*!
 Load the provided \a blob from the network or filesystem.
 
@@ -1268,6 +1300,91 @@ void QQmlTypeLoader::setData(QQmlDataBlob *blob, const QQmlDataBlob::SourceCodeD
 
     blob->dataReceived(d);
 
+    if (blob->m_isParsing) {
+        // Loading continues in parsingDoneThread() once the document is parsed.
+        blob->m_inCallback = false;
+        return;
+    }
+
+    if (!blob->isError() && !blob->isWaiting())
+        blob->allDependenciesDone();
+
+    if (blob->status() != QQmlDataBlob::Error)
+        blob->m_data.setStatus(QQmlDataBlob::WaitingForDependencies);
+
+    blob->m_inCallback = false;
+
+    blob->tryDone();
+}
+
+class QQmlTypeDataParser : public QRunnable
+{
+public:
+    QQmlTypeDataParser(QQmlTypeData *blob, const QSet<QString> &illegalNames)
+        : m_blob(blob), m_illegalNames(illegalNames)
+    {}
+
+    void run() override
+    {
+        // Only the document and the errors of the blob are touched here. The loader thread
+        // leaves them alone until it gets the blob back.
+        m_blob->parseSource(m_illegalNames, &m_blob->m_parseErrors);
+        m_blob->typeLoader()->m_thread->parsingDone(m_blob);
+    }
+
+private:
+    QQmlTypeData *m_blob;
+    QSet<QString> m_illegalNames;
+};
+
+/*!
+Parses the source of \a blob on the parser pool, so that independent documents can be parsed
+in parallel. Everything that needs the engine, like resolving types and compiling the document,
+still happens on the loader thread once parsingDoneThread() is called.
+
+Returns false if the blob should be parsed on the loader thread instead. That is the case while
+the engine thread waits for a synchronous load, which has to be complete when it returns.
+*/
+bool QQmlTypeLoader::parseInBackground(QQmlTypeData *blob)
+{
+    ASSERT_LOADTHREAD();
+
+    if (disableParallelParsing() || m_parserPool.maxThreadCount() < 2
+            || m_synchronousLoads.load() > 0) {
+        return false;
+    }
+
+    // Anything that needs the engine, or lazily initializes the blob, is done up front.
+    blob->m_document.reset(new QmlIR::Document(blob->isDebugging()));
+    blob->finalUrlString();
+
+    blob->addref();
+    blob->m_isParsing = true;
+    m_parserPool.start(new QQmlTypeDataParser(blob, QV8Engine::get(engine())->illegalNames()));
+    return true;
+}
+
+void QQmlTypeLoader::parsingDoneThread(QQmlTypeData *blob)
+{
+    ASSERT_LOADTHREAD();
+
+    QML_MEMORY_SCOPE_URL(blob->url());
+    QQmlCompilingProfiler prof(QQmlEnginePrivate::get(engine())->profiler, blob);
+
+    blob->m_inCallback = true;
+    blob->m_isParsing = false;
+
+    if (m_thread->isShutdown()) {
+        QQmlError error;
+        error.setDescription(QLatin1String("Interrupted by shutdown"));
+        blob->setError(error);
+    } else if (!blob->m_parseErrors.isEmpty()) {
+        blob->setError(blob->m_parseErrors);
+    } else {
+        blob->continueLoadFromIR();
+    }
+    blob->m_parseErrors.clear();
+
     if (!blob->isError() && !blob->isWaiting())
         blob->allDependenciesDone();
 
@@ -1301,6 +1418,9 @@ void QQmlTypeLoader::setCachedUnit(QQmlDataBlob *blob, const QQmlPrivate::Cached
 
 void QQmlTypeLoader::shutdownThread()
 {
+    // Parser jobs post their results to the loader thread, so let them finish first.
+    m_parserPool.waitForDone();
+
     if (m_thread && !m_thread->isShutdown())
         m_thread->shutdown();
 }
@@ -1654,11 +1774,13 @@ QQmlTypeData *QQmlTypeLoader::getType(const QUrl &url, Mode mode)
             // this only works when called directly from the UI thread, but not
             // when recursively called on the QML thread via resolveTypes()
 
+            m_synchronousLoads.ref();
             while (!typeData->isCompleteOrError()) {
                 unlock();
-                m_thread->waitForNextMessage();
+                waitForLoaderThread();
                 lock();
             }
+            m_synchronousLoads.deref();
         }
     }
 
@@ -2079,6 +2201,7 @@ bool QQmlTypeData::tryLoadFromDiskCache()
         QString error;
         if (!unit->loadFromDisk(url(), m_backupSourceCode.sourceTimeStamp(), v4->iselFactory.data(), &error)) {
             qCDebug(DBG_DISK_CACHE) << "Error loading" << url().toString() << "from disk cache:" << error;
+            QQmlStartupTrace::addDiskCacheMiss(url(), error);
             return false;
         }
     }
@@ -2266,12 +2389,17 @@ void QQmlTypeData::done()
     };
 
     // verify if any dependencies changed if we're using a cache
-    if (m_document.isNull() && !m_compiledData->verifyChecksum(dependencyHasher)) {
-        qCDebug(DBG_DISK_CACHE) << "Checksum mismatch for cached version of" << m_compiledData->url().toString();
-        if (!loadFromSource())
-            return;
-        m_backupSourceCode = SourceCodeData();
-        m_compiledData = nullptr;
+    if (m_document.isNull()) {
+        if (!m_compiledData->verifyChecksum(dependencyHasher)) {
+            qCDebug(DBG_DISK_CACHE) << "Checksum mismatch for cached version of" << m_compiledData->url().toString();
+            QQmlStartupTrace::addDiskCacheMiss(url(), QStringLiteral("Dependency checksum mismatch"));
+            if (!loadFromSource())
+                return;
+            m_backupSourceCode = SourceCodeData();
+            m_compiledData = nullptr;
+        } else {
+            QQmlStartupTrace::addDiskCacheHit(url());
+        }
     }
 
     if (!m_document.isNull()) {
@@ -2392,6 +2520,9 @@ void QQmlTypeData::dataReceived(const SourceCodeData &data)
         return;
     }
 
+    if (typeLoader()->parseInBackground(this))
+        return;
+
     if (!loadFromSource())
         return;
 
@@ -2408,29 +2539,42 @@ void QQmlTypeData::initializeFromCachedUnit(const QQmlPrivate::CachedQmlUnit *un
 bool QQmlTypeData::loadFromSource()
 {
     m_document.reset(new QmlIR::Document(isDebugging()));
+    QList<QQmlError> errors;
+    if (!parseSource(QV8Engine::get(typeLoader()->engine())->illegalNames(), &errors)) {
+        setError(errors);
+        return false;
+    }
+    return true;
+}
+
+// Parses the source into the already created document. This does not touch the engine, so that
+// it can run on the parser pool.
+bool QQmlTypeData::parseSource(const QSet<QString> &illegalNames, QList<QQmlError> *errors)
+{
+    QQmlStartupTrace::Range traceRange(QQmlStartupTrace::Parse, finalUrlString());
     m_document->jsModule.sourceTimeStamp = m_backupSourceCode.sourceTimeStamp();
-    QQmlEngine *qmlEngine = typeLoader()->engine();
-    QmlIR::IRBuilder compiler(QV8Engine::get(qmlEngine)->illegalNames());
+    QmlIR::IRBuilder compiler(illegalNames);
 
     QString sourceError;
     const QString source = m_backupSourceCode.readAll(&sourceError);
     if (!sourceError.isEmpty()) {
-        setError(sourceError);
+        QQmlError e;
+        e.setUrl(finalUrl());
+        e.setDescription(sourceError);
+        *errors << e;
         return false;
     }
 
     if (!compiler.generateFromQml(source, finalUrlString(), m_document.data())) {
-        QList<QQmlError> errors;
-        errors.reserve(compiler.errors.count());
+        errors->reserve(compiler.errors.count());
         for (const QQmlJS::DiagnosticMessage &msg : qAsConst(compiler.errors)) {
             QQmlError e;
             e.setUrl(finalUrl());
             e.setLine(msg.loc.startLine);
             e.setColumn(msg.loc.startColumn);
             e.setDescription(msg.message);
-            errors << e;
+            *errors << e;
         }
-        setError(errors);
         return false;
     }
     return true;
@@ -2542,6 +2686,7 @@ void QQmlTypeData::compile(const QQmlRefPointer<QQmlTypeNameCache> &typeNameCach
                            const QV4::CompiledData::DependentTypesHasher &dependencyHasher)
 {
     Q_ASSERT(m_compiledData.isNull());
+    QQmlStartupTrace::Range traceRange(QQmlStartupTrace::Compile, finalUrlString());
 
     const bool typeRecompilation = m_document && m_document->javaScriptCompilationUnit && m_document->javaScriptCompilationUnit->data->flags & QV4::CompiledData::Unit::PendingTypeCompilation;
 
@@ -2913,6 +3058,7 @@ QQmlScriptData *QQmlScriptBlob::scriptData() const
 struct EmptyCompilationUnit : public QV4::CompiledData::CompilationUnit
 {
     void linkBackendToEngine(QV4::ExecutionEngine *) override {}
+    QV4::Function *createRuntimeFunction(int) override { return nullptr; }
 };
 
 void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
@@ -2923,13 +3069,17 @@ void QQmlScriptBlob::dataReceived(const SourceCodeData &data)
         QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit = v4->iselFactory->createUnitForLoading();
         QString error;
         if (unit->loadFromDisk(url(), data.sourceTimeStamp(), v4->iselFactory.data(), &error)) {
+            QQmlStartupTrace::addDiskCacheHit(url());
             initializeFromCompilationUnit(unit);
             return;
         } else {
             qCDebug(DBG_DISK_CACHE()) << "Error loading" << url().toString() << "from disk cache:" << error;
+            QQmlStartupTrace::addDiskCacheMiss(url(), error);
         }
     }
 
+    QQmlStartupTrace::Range traceRange(QQmlStartupTrace::Compile, finalUrlString());
+
 
     QmlIR::Document irUnit(isDebugging());
 
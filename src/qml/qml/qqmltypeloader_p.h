@@ -55,6 +55,7 @@
 #include <QtCore/qobject.h>
 #include <QtCore/qatomic.h>
 #include <QtCore/qfileinfo.h>
+#include <QtCore/qthreadpool.h>
 #if QT_CONFIG(qml_network)
 #include <QtNetwork/qnetworkreply.h>
 #endif
@@ -212,9 +213,10 @@ private:
     // List of QQmlDataBlob's that I am waiting for to complete.
     QList<QQmlDataBlob *> m_waitingFor;
 
-    int m_redirectCount:30;
+    int m_redirectCount:29;
     bool m_inCallback:1;
     bool m_isDone:1;
+    bool m_isParsing:1; // dataReceived() handed the source to the parser pool
 };
 
 class QQmlTypeLoaderThread;
@@ -342,6 +344,8 @@ private:
     void setData(QQmlDataBlob *, const QString &fileName);
     void setData(QQmlDataBlob *, const QQmlDataBlob::SourceCodeData &);
     void setCachedUnit(QQmlDataBlob *blob, const QQmlPrivate::CachedQmlUnit *unit);
+    bool parseInBackground(QQmlTypeData *blob);
+    void parsingDoneThread(QQmlTypeData *blob);
 
     template<typename T>
     struct TypedCallback
@@ -377,14 +381,18 @@ private:
     QmldirCache m_qmldirCache;
     ImportDirCache m_importDirCache;
     ImportQmlDirCache m_importQmlDirCache;
+    QThreadPool m_parserPool;
+    QAtomicInt m_synchronousLoads; // engine thread is waiting in doLoad() or getType()
 
     template<typename Loader>
     void doLoad(const Loader &loader, QQmlDataBlob *blob, Mode mode);
+    void waitForLoaderThread();
     void updateTypeCacheTrimThreshold();
 
     friend struct PlainLoader;
     friend struct CachedLoader;
     friend struct StaticLoader;
+    friend class QQmlTypeDataParser;
 };
 
 class Q_AUTOTEST_EXPORT QQmlTypeData : public QQmlTypeLoader::Blob
@@ -446,8 +454,11 @@ protected:
     QString stringAt(int index) const override;
 
 private:
+    friend class QQmlTypeDataParser;
+
     bool tryLoadFromDiskCache();
     bool loadFromSource();
+    bool parseSource(const QSet<QString> &illegalNames, QList<QQmlError> *errors);
     void restoreIR(QQmlRefPointer<QV4::CompiledData::CompilationUnit> unit);
     void continueLoadFromIR();
     void resolveTypes();
@@ -485,6 +496,8 @@ private:
 
     bool m_implicitImportLoaded;
     bool loadImplicitImport();
+
+    QList<QQmlError> m_parseErrors; // written by the parser pool while m_isParsing is set
 };
 
 // QQmlScriptData instances are created, uninitialized, by the loader in the
@@ -289,7 +289,7 @@ void QQmlConnections::connectSignals()
 
             QQmlBoundSignalExpression *expression = ctxtdata ?
                 new QQmlBoundSignalExpression(target, signalIndex,
-                                              ctxtdata, this, d->compilationUnit->runtimeFunctions[binding->value.compiledScriptIndex]) : 0;
+                                              ctxtdata, this, d->compilationUnit->runtimeFunction(binding->value.compiledScriptIndex)) : 0;
             signal->takeExpression(expression);
             d->boundsignals += signal;
         } else {
@@ -86,7 +86,7 @@ void QQmlListModelWorkerAgent::Data::changedChange(int uid, int index, int count
 }
 
 QQmlListModelWorkerAgent::QQmlListModelWorkerAgent(QQmlListModel *model)
-: m_ref(1), m_orig(model), m_copy(new QQmlListModel(model, this))
+: m_ref(1), m_engine(0), m_orig(model), m_copy(new QQmlListModel(model, this))
 {
 }
 
@@ -97,9 +97,17 @@ QQmlListModelWorkerAgent::~QQmlListModelWorkerAgent()
     mutex.unlock();
 }
 
-void QQmlListModelWorkerAgent::setEngine(QV4::ExecutionEngine *eng)
+/*
+   Worker scripts may run on different threads, each with its own engine. The copy of the
+   model is not thread safe, so it stays with the engine of the first worker script it is sent
+   to. Returns false if \a eng is not that engine.
+*/
+bool QQmlListModelWorkerAgent::setEngine(QV4::ExecutionEngine *eng)
 {
+    if (!m_engine.testAndSetOrdered(0, eng) && m_engine.load() != eng)
+        return false;
     m_copy->m_engine = eng;
+    return true;
 }
 
 void QQmlListModelWorkerAgent::addref()
@@ -72,7 +72,7 @@ class QQmlListModelWorkerAgent : public QObject
 public:
     QQmlListModelWorkerAgent(QQmlListModel *);
     ~QQmlListModelWorkerAgent();
-    void setEngine(QV4::ExecutionEngine *eng);
+    bool setEngine(QV4::ExecutionEngine *eng);
 
     void addref();
     void release();
@@ -147,6 +147,7 @@ private:
     };
 
     QAtomicInt m_ref;
+    QAtomicPointer<QV4::ExecutionEngine> m_engine;
     QQmlListModel *m_orig;
     QQmlListModel *m_copy;
     QMutex mutex;
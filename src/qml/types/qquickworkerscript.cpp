@@ -184,6 +184,7 @@ public:
     QV4::ReturnedValue getWorker(WorkerScript *);
 
     int m_nextId;
+    int m_activeWorkers; // only accessed from the thread owning the QQmlEngine
 
     static void method_sendMessage(const QV4::BuiltinFunction *, QV4::Scope &scope, QV4::CallData *callData);
 
@@ -288,7 +289,7 @@ QNetworkAccessManager *QQuickWorkerScriptEnginePrivate::WorkerEngine::networkAcc
 #endif
 
 QQuickWorkerScriptEnginePrivate::QQuickWorkerScriptEnginePrivate(QQmlEngine *engine)
-: workerEngine(0), qmlengine(engine), m_nextId(0)
+: workerEngine(0), qmlengine(engine), m_nextId(0), m_activeWorkers(0)
 {
 }
 
@@ -535,6 +536,8 @@ int QQuickWorkerScriptEngine::registerWorkerScript(QQuickWorkerScript *owner)
     d->workers.insert(script->id, script);
     d->m_lock.unlock();
 
+    ++d->m_activeWorkers;
+
     return script->id;
 }
 
@@ -543,6 +546,7 @@ void QQuickWorkerScriptEngine::removeWorkerScript(int id)
     QQuickWorkerScriptEnginePrivate::WorkerScript* script = d->workers.value(id);
     if (script) {
         script->owner = 0;
+        --d->m_activeWorkers;
         QCoreApplication::postEvent(d, new WorkerRemoveEvent(id));
     }
 }
@@ -557,6 +561,11 @@ void QQuickWorkerScriptEngine::sendMessage(int id, const QByteArray &data)
     QCoreApplication::postEvent(d, new WorkerDataEvent(id, data));
 }
 
+int QQuickWorkerScriptEngine::workerScriptCount() const
+{
+    return d->m_activeWorkers;
+}
+
 void QQuickWorkerScriptEngine::run()
 {
     d->m_lock.lock();
@@ -620,6 +629,20 @@ void QQuickWorkerScriptEngine::run()
 
     Worker script can not use \l {qtqml-javascript-imports.html}{.import} syntax.
 
+    \section3 Worker Threads
+
+    By default, all worker scripts of a QML engine run on a single thread. Setting the
+    \c QML_WORKERSCRIPT_MAX_THREADS environment variable to a larger number lets them
+    share a pool of up to that many threads instead. Each worker script stays on the
+    thread it was first assigned to, so its messages are always processed in order,
+    but independent worker scripts may run in parallel on different threads.
+
+    A ListModel that is sent to worker scripts stays with the thread of the first
+    worker script that receives it. With more than one thread, sending it to a worker
+    script on another thread prints a warning, and that worker script receives
+    \c undefined instead. Applications that share one ListModel between several
+    worker scripts should not enable the thread pool.
+
     \sa {Qt Quick Examples - Threading},
         {Threaded ListModel Example}
 */
@@ -156,6 +156,12 @@ void QQmlProfilerClient::memoryAllocation(QQmlProfilerDefinitions::MemoryType ty
     Q_UNUSED(amount);
 }
 
+void QQmlProfilerClient::garbageCollection(qint64 time, const QV4::GCStatistics &statistics)
+{
+    Q_UNUSED(time);
+    Q_UNUSED(statistics);
+}
+
 void QQmlProfilerClient::inputEvent(QQmlProfilerDefinitions::InputEventType type, qint64 time,
                                     int a, int b)
 {
@@ -322,6 +328,27 @@ void QQmlProfilerClient::messageReceived(const QByteArray &data)
         qint64 delta;
         stream >> type >> delta;
         memoryAllocation((QQmlProfilerDefinitions::MemoryType)type, time, delta);
+    } else if (messageType == QQmlProfilerDefinitions::GarbageCollection) {
+        if (!(d->features & one << QQmlProfilerDefinitions::ProfileMemory))
+            return;
+        int trigger;
+        qint64 usedBefore, usedAfter, largeItemsBefore, largeItemsAfter, chunks, releasedChunks,
+                unmanagedHeapBefore, unmanagedHeapAfter;
+        QV4::GCStatistics statistics;
+        stream >> trigger >> statistics.minorCollection >> statistics.incremental
+               >> statistics.markTime >> statistics.sweepTime >> usedBefore >> usedAfter
+               >> largeItemsBefore >> largeItemsAfter >> chunks >> releasedChunks
+               >> unmanagedHeapBefore >> unmanagedHeapAfter;
+        statistics.trigger = static_cast<QV4::GCStatistics::Trigger>(trigger);
+        statistics.usedBefore = usedBefore;
+        statistics.usedAfter = usedAfter;
+        statistics.largeItemsBefore = largeItemsBefore;
+        statistics.largeItemsAfter = largeItemsAfter;
+        statistics.chunks = chunks;
+        statistics.releasedChunks = releasedChunks;
+        statistics.unmanagedHeapBefore = unmanagedHeapBefore;
+        statistics.unmanagedHeapAfter = unmanagedHeapAfter;
+        garbageCollection(time, statistics);
     } else {
         int range;
         stream >> range;
@@ -97,6 +97,8 @@ private:
     virtual void memoryAllocation(QQmlProfilerDefinitions::MemoryType type, qint64 time,
                                   qint64 amount);
 
+    virtual void garbageCollection(qint64 time, const QV4::GCStatistics &statistics);
+
     virtual void inputEvent(QQmlProfilerDefinitions::InputEventType type, qint64 time, int a,
                             int b);
 
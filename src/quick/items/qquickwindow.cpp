@@ -71,6 +71,8 @@
 #include <QtQuick/private/qquickpixmapcache_p.h>
 
 #include <private/qqmlmemoryprofiler_p.h>
+#include <private/qv8engine_p.h>
+#include <private/qv4mm_p.h>
 #include <private/qqmldebugserviceinterfaces_p.h>
 #include <private/qqmldebugconnector_p.h>
 #if QT_CONFIG(opengl)
@@ -151,6 +153,7 @@ public slots:
                     incubateAgain();
             }
         }
+        collectGarbageIncrementally();
     }
 
     void animationStopped() { incubate(); }
@@ -163,6 +166,17 @@ protected:
     }
 
 private:
+    void collectGarbageIncrementally()
+    {
+        // Use the idle time in the frame for a step of a running incremental JS
+        // garbage collection, so that it doesn't have to be finished in one pause.
+        if (!engine())
+            return;
+        QV4::MemoryManager *mm = QV8Engine::getV4(engine())->memoryManager;
+        if (mm->isIncrementalGCRunning())
+            mm->runIncrementalGCStep();
+    }
+
     QSGRenderLoop *m_renderLoop;
     int m_incubation_time;
     int m_timer;
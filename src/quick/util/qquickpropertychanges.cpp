@@ -287,7 +287,7 @@ void QQuickPropertyChangesPrivate::decodeBinding(const QString &propertyPrefix,
         QQuickReplaceSignalHandler *handler = new QQuickReplaceSignalHandler;
         handler->property = prop;
         handler->expression.take(new QQmlBoundSignalExpression(object, QQmlPropertyPrivate::get(prop)->signalIndex(),
-                                                               QQmlContextData::get(qmlContext(q)), object, compilationUnit->runtimeFunctions.at(binding->value.compiledScriptIndex)));
+                                                               QQmlContextData::get(qmlContext(q)), object, compilationUnit->runtimeFunction(binding->value.compiledScriptIndex)));
         signalReplacements << handler;
         return;
     }
@@ -457,7 +457,7 @@ QQuickPropertyChanges::ActionList QQuickPropertyChanges::actions()
                 QV4::Scope scope(QQmlEnginePrivate::getV4Engine(qmlEngine(this)));
                 QV4::Scoped<QV4::QmlContext> qmlContext(scope, QV4::QmlContext::create(scope.engine->rootContext(), context, object()));
                 newBinding = QQmlBinding::create(&QQmlPropertyPrivate::get(prop)->core,
-                                                 d->compilationUnit->runtimeFunctions.at(e.id), object(), context, qmlContext);
+                                                 d->compilationUnit->runtimeFunction(e.id), object(), context, qmlContext);
             }
 //            QQmlBinding *newBinding = e.id != QQmlBinding::Invalid ? QQmlBinding::createBinding(e.id, object(), qmlContext(this)) : 0;
             if (!newBinding)
@@ -0,0 +1,11 @@
+import QtQml 2.0
+
+QtObject {
+    property int width: 400
+
+    onWidthChanged: {
+        gc();
+        console.log("collected");
+    }
+    Component.onCompleted: width = 500;
+}
@@ -21,4 +21,6 @@ OTHER_FILES += \
     data/TestImage_2x2.png \
     data/signalSourceLocation.qml \
     data/javascript.qml \
-    data/timer.qml
+    data/timer.qml \
+    data/garbageCollection.qml \
+    data/importResolution.qml
@@ -72,6 +72,7 @@ public:
     QVector<QQmlProfilerData> jsHeapMessages;
     QVector<QQmlProfilerData> asynchronousMessages;
     QVector<QQmlProfilerData> pixmapMessages;
+    QVector<QV4::GCStatistics> gcMessages;
 
     qint64 lastTimestamp;
 
@@ -93,6 +94,7 @@ private:
     void pixmapCacheEvent(QQmlProfilerDefinitions::PixmapEventType type, qint64 time,
                           const QString &url, int numericData1, int numericData2);
     void memoryAllocation(QQmlProfilerDefinitions::MemoryType type, qint64 time, qint64 amount);
+    void garbageCollection(qint64 time, const QV4::GCStatistics &statistics);
     void inputEvent(QQmlProfilerDefinitions::InputEventType type, qint64 time, int a, int b);
     void complete();
 
@@ -229,6 +231,13 @@ void QQmlProfilerTestClient::memoryAllocation(QQmlProfilerDefinitions::MemoryTyp
     jsHeapMessages.append(data);
 }
 
+void QQmlProfilerTestClient::garbageCollection(qint64 time, const QV4::GCStatistics &statistics)
+{
+    QVERIFY(lastTimestamp <= time);
+    lastTimestamp = time;
+    gcMessages.append(statistics);
+}
+
 void QQmlProfilerTestClient::inputEvent(QQmlProfilerDefinitions::InputEventType type, qint64 time,
                                         int a, int b)
 {
@@ -311,6 +320,8 @@ private slots:
     void signalSourceLocation();
     void javascript();
     void flushInterval();
+    void garbageCollection();
+    void importResolution();
 };
 
 #define VERIFY(type, position, expected, checks) QVERIFY(verify(type, position, expected, checks))
@@ -683,16 +694,28 @@ void tst_QQmlProfilerService::signalSourceLocation()
     checkTraceReceived();
     checkJsHeap();
 
+    // Resolving the imports adds Compiling ranges in front, so look for the first handler.
+    int signalStart = -1;
+    for (int i = 0; i < m_client->qmlMessages.length(); ++i) {
+        const QQmlProfilerData &data = m_client->qmlMessages.at(i);
+        if (data.messageType == QQmlProfilerDefinitions::RangeStart
+                && data.detailType == QQmlProfilerDefinitions::HandlingSignal) {
+            signalStart = i;
+            break;
+        }
+    }
+    QVERIFY(signalStart >= 0);
+
     QQmlProfilerData expected(0, QQmlProfilerDefinitions::RangeLocation,
                               QQmlProfilerDefinitions::HandlingSignal,
                               QLatin1String("signalSourceLocation.qml"));
     expected.line = 8;
     expected.column = 28;
-    VERIFY(MessageListQML, 9, expected, CheckAll);
+    VERIFY(MessageListQML, signalStart + 1, expected, CheckAll);
 
     expected.line = 7;
     expected.column = 21;
-    VERIFY(MessageListQML, 11, expected, CheckAll);
+    VERIFY(MessageListQML, signalStart + 3, expected, CheckAll);
 }
 
 void tst_QQmlProfilerService::javascript()
@@ -741,6 +764,55 @@ void tst_QQmlProfilerService::flushInterval()
     checkJsHeap();
 }
 
+void tst_QQmlProfilerService::garbageCollection()
+{
+    connect(true, "garbageCollection.qml");
+
+    m_client->sendRecordingStatus(true);
+    while (!(m_process->output().contains(QLatin1String("collected"))))
+        QVERIFY(QQmlDebugTest::waitForSignal(m_process, SIGNAL(readyReadStandardOutput())));
+    m_client->sendRecordingStatus(false);
+    checkTraceReceived();
+    checkJsHeap();
+
+    bool seenExplicit = false;
+    foreach (const QV4::GCStatistics &statistics, m_client->gcMessages) {
+        QVERIFY(statistics.markTime >= 0);
+        QVERIFY(statistics.sweepTime >= 0);
+        QVERIFY(statistics.chunks > 0);
+        if (statistics.trigger == QV4::GCStatistics::ExplicitTrigger) {
+            // gc() always runs a major collection
+            QVERIFY(!statistics.minorCollection);
+            seenExplicit = true;
+        }
+    }
+    QVERIFY2(seenExplicit, "No garbage collection triggered by gc() seen");
+}
+
+void tst_QQmlProfilerService::importResolution()
+{
+    connect(true, "importResolution.qml");
+
+    m_client->sendRecordingStatus(true);
+    while (!(m_process->output().contains(QLatin1String("loaded"))))
+        QVERIFY(QQmlDebugTest::waitForSignal(m_process, SIGNAL(readyReadStandardOutput())));
+    m_client->sendRecordingStatus(false);
+    checkTraceReceived();
+    checkJsHeap();
+
+    // Locating the module's qmldir shows up as a Compiling range named after the module.
+    bool seenQmldir = false;
+    foreach (const QQmlProfilerData &data, m_client->qmlMessages) {
+        if (data.messageType == QQmlProfilerDefinitions::RangeData
+                && data.detailType == QQmlProfilerDefinitions::Compiling
+                && data.detailData == QLatin1String("QtQuick")) {
+            seenQmldir = true;
+            break;
+        }
+    }
+    QVERIFY2(seenQmldir, "No Compiling range for resolving the QtQuick qmldir seen");
+}
+
 QTEST_MAIN(tst_QQmlProfilerService)
 
 #include "tst_qqmlprofilerservice.moc"
@@ -195,6 +195,9 @@ private slots:
 
     void withNoContext();
     void holeInPropertyData();
+    void megamorphicPropertyLookup();
+    void objectLiteralShapes();
+    void untypedRelationalOperators();
 
     void basicBlockMergeAfterLoopPeeling();
 
@@ -4073,6 +4076,88 @@ void tst_QJSEngine::holeInPropertyData()
     QVERIFY(ok.toBool());
 }
 
+void tst_QJSEngine::megamorphicPropertyLookup()
+{
+    QJSEngine engine;
+    QJSValue ok = engine.evaluate(
+                "function read(o) { return o.value; }\n"
+                "var proto = { value: 'proto' };\n"
+                "var objects = [];\n"
+                "for (var i = 0; i < 20; ++i) {\n"
+                "    var o = (i % 4 == 0) ? Object.create(proto) : {};\n"
+                "    o['pad' + i] = i;\n"
+                "    if (i % 4 != 0)\n"
+                "        o.value = i;\n"
+                "    objects.push(o);\n"
+                "}\n"
+                "var accessor = { get value() { return 'accessor'; } };\n"
+                "var result = true;\n"
+                "for (var round = 0; round < 3; ++round) {\n"
+                "    for (var i = 0; i < objects.length; ++i)\n"
+                "        result = result && read(objects[i]) === ((i % 4 == 0) ? 'proto' : i);\n"
+                "    result = result && read(accessor) === 'accessor' && read('abc') === undefined;\n"
+                "}\n"
+                "proto.value = 'changed';\n"
+                "objects[1].value = 'own';\n"
+                "result && read(objects[0]) === 'changed' && read(objects[1]) === 'own';");
+    QVERIFY(ok.isBool());
+    QVERIFY(ok.toBool());
+}
+
+void tst_QJSEngine::objectLiteralShapes()
+{
+    QJSEngine engine;
+    QJSValue ok = engine.evaluate(
+                "function row(i) { return { id: i, name: 'row' + i, 2: i * 2 }; }\n"
+                "function other(i) { return { id: i, name: 'other', get twice() { return this.id * 2; } }; }\n"
+                "var rows = [];\n"
+                "for (var i = 0; i < 1000; ++i) {\n"
+                "    rows.push(row(i));\n"
+                "    rows.push(other(i));\n"
+                "}\n"
+                "var result = true;\n"
+                "for (var i = 0; i < 1000; ++i) {\n"
+                "    var a = rows[2 * i], b = rows[2 * i + 1];\n"
+                "    result = result && a.id === i && a.name === 'row' + i && a[2] === i * 2;\n"
+                "    result = result && b.id === i && b.name === 'other' && b.twice === i * 2;\n"
+                "}\n"
+                "result && Object.keys(rows[0]).join() === '2,id,name';");
+    QVERIFY(ok.isBool());
+    QVERIFY(ok.toBool());
+}
+
+void tst_QJSEngine::untypedRelationalOperators()
+{
+    QJSEngine engine;
+    engine.evaluate(
+                "function compare(a, b) {\n"
+                "    var r = '';\n"
+                "    r += (a < b) ? '1' : '0';\n"
+                "    if (a > b) r += '1'; else r += '0';\n"
+                "    r += (a <= b) ? '1' : '0';\n"
+                "    if (a >= b) r += '1'; else r += '0';\n"
+                "    return r;\n"
+                "}\n");
+    QJSValue compare = engine.globalObject().property("compare");
+    QVERIFY(compare.isCallable());
+
+    QJSValue valueOfFour = engine.evaluate("({ valueOf: function() { return 4; } })");
+
+    for (int i = 0; i < 2; ++i) {
+        QCOMPARE(compare.call(QJSValueList() << 1 << 2).toString(), QStringLiteral("1010"));
+        QCOMPARE(compare.call(QJSValueList() << 2.5 << 2).toString(), QStringLiteral("0101"));
+        QCOMPARE(compare.call(QJSValueList() << -3 << -3.0).toString(), QStringLiteral("0011"));
+        QCOMPARE(compare.call(QJSValueList() << qQNaN() << 1).toString(), QStringLiteral("0000"));
+        QCOMPARE(compare.call(QJSValueList() << 1 << qQNaN()).toString(), QStringLiteral("0000"));
+        QCOMPARE(compare.call(QJSValueList() << QStringLiteral("10") << QStringLiteral("9")).toString(), QStringLiteral("1010"));
+        QCOMPARE(compare.call(QJSValueList() << QStringLiteral("10") << 9).toString(), QStringLiteral("0101"));
+        QCOMPARE(compare.call(QJSValueList() << QJSValue() << 0).toString(), QStringLiteral("0000"));
+        QCOMPARE(compare.call(QJSValueList() << QJSValue(QJSValue::NullValue) << 0).toString(), QStringLiteral("0011"));
+        QCOMPARE(compare.call(QJSValueList() << true << 1).toString(), QStringLiteral("0011"));
+        QCOMPARE(compare.call(QJSValueList() << valueOfFour << 3).toString(), QStringLiteral("0101"));
+    }
+}
+
 void tst_QJSEngine::basicBlockMergeAfterLoopPeeling()
 {
     QJSEngine engine;
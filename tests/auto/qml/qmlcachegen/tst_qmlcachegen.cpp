@@ -41,8 +41,12 @@ class tst_qmlcachegen: public QObject
 private slots:
     void initTestCase();
 
+    void loadFromBundle();
     void loadGeneratedFile();
     void translationExpressionSupport();
+
+private:
+    QTemporaryDir bundleDir;
 };
 
 // A wrapper around QQmlComponent to ensure the temporary reference counts
@@ -67,12 +71,12 @@ public:
     }
 };
 
-static bool generateCache(const QString &qmlFileName)
+static bool runQmlCacheGen(const QStringList &arguments)
 {
     QProcess proc;
     proc.setProcessChannelMode(QProcess::ForwardedChannels);
     proc.setProgram(QLibraryInfo::location(QLibraryInfo::BinariesPath) + QDir::separator() + QLatin1String("qmlcachegen"));
-    proc.setArguments(QStringList() << (QLatin1String("--target-architecture=") + QSysInfo::buildCpuArchitecture()) << (QLatin1String("--target-abi=") + QSysInfo::buildAbi()) << qmlFileName);
+    proc.setArguments(arguments);
     proc.start();
     if (!proc.waitForFinished())
         return false;
@@ -81,9 +85,61 @@ static bool generateCache(const QString &qmlFileName)
     return proc.exitCode() == 0;
 }
 
+static bool generateCache(const QString &qmlFileName)
+{
+    return runQmlCacheGen(QStringList() << (QLatin1String("--target-architecture=") + QSysInfo::buildCpuArchitecture()) << (QLatin1String("--target-abi=") + QSysInfo::buildAbi()) << qmlFileName);
+}
+
 void tst_qmlcachegen::initTestCase()
 {
     qputenv("QML_FORCE_DISK_CACHE", "1");
+
+    // Bundles are registered once per process, before the first cache file is loaded.
+    QVERIFY(bundleDir.isValid());
+    qputenv("QML_DISK_CACHE_BUNDLES", QFile::encodeName(bundleDir.path() + QLatin1String("/app.qmlcb")));
+}
+
+void tst_qmlcachegen::loadFromBundle()
+{
+    const auto writeTempFile = [this](const QString &fileName, const char *contents) {
+        QFile f(bundleDir.path() + '/' + fileName);
+        const bool ok = f.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        Q_ASSERT(ok);
+        f.write(contents);
+        return f.fileName();
+    };
+
+    const QString mainFilePath = writeTempFile("main.qml", "import QtQml 2.0\n"
+                                                           "Helper {\n"
+                                                           "    property int value: Math.min(100, helperValue);\n"
+                                                           "}");
+    const QString helperFilePath = writeTempFile("Helper.qml", "import QtQml 2.0\n"
+                                                               "QtObject {\n"
+                                                               "    property int helperValue: 42\n"
+                                                               "}");
+
+    QVERIFY(generateCache(mainFilePath));
+    QVERIFY(generateCache(helperFilePath));
+
+    const QString bundleFilePath = bundleDir.path() + QLatin1String("/app.qmlcb");
+    QVERIFY(runQmlCacheGen(QStringList() << QLatin1String("--bundle")
+                           << QLatin1String("--bundle-root") << bundleDir.path()
+                           << QLatin1String("--bundle-prefix") << (bundleDir.path() + QLatin1Char('/'))
+                           << QLatin1String("-o") << bundleFilePath
+                           << (mainFilePath + QLatin1Char('c')) << (helperFilePath + QLatin1Char('c'))));
+    QVERIFY(QFile::exists(bundleFilePath));
+
+    // The individual cache files are not needed anymore, and main.qml can only be loaded from the
+    // bundle. Helper.qml stays, as the implicit directory import looks for the source file.
+    QVERIFY(QFile::remove(mainFilePath));
+    QVERIFY(QFile::remove(mainFilePath + QLatin1Char('c')));
+    QVERIFY(QFile::remove(helperFilePath + QLatin1Char('c')));
+
+    QQmlEngine engine;
+    CleanlyLoadingComponent component(&engine, QUrl::fromLocalFile(mainFilePath));
+    QScopedPointer<QObject> obj(component.create());
+    QVERIFY2(!obj.isNull(), qPrintable(component.errorString()));
+    QCOMPARE(obj->property("value").toInt(), 42);
 }
 
 void tst_qmlcachegen::loadGeneratedFile()
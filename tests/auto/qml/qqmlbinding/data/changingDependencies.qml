@@ -0,0 +1,10 @@
+import QtQml 2.0
+
+QtObject {
+    property bool useExtra: false
+    property int a: 1
+    property int b: 2
+    property int c: 3
+    property int extra: 10
+    property int result: useExtra ? extra + a + b + c : a + b + c
+}
@@ -0,0 +1,6 @@
+import QtQml 2.0
+
+QtObject {
+    property int pingPong: pong + 1
+    property int pong: pingPong + 1
+}
@@ -0,0 +1,15 @@
+import QtQml 2.0
+
+QtObject {
+    property int source: 1
+    property int left: source * 2
+    property int right: source * 3
+    property int sum: left + right
+
+    property int sumChangeCount: 0
+    onSumChanged: ++sumChangeCount
+
+    function updateSource() {
+        source = 2
+    }
+}
@@ -0,0 +1,29 @@
+import QtQuick 2.0
+
+Item {
+    id: root
+    property int count: 1
+    property int countCopy: count
+    property string label: source.text
+    property color tint: source.color
+    property real sourceWidth: source.width
+    property real scaledWidth: source.width * 2
+
+    Rectangle {
+        id: source
+        objectName: "source"
+        property string text: "a"
+        color: "red"
+        width: 10
+        opacity: root.count / 4
+    }
+
+    // Created after source, so its binding runs while source.opacity is still pending.
+    Item {
+        id: reader
+        objectName: "reader"
+        property real sourceOpacity: source.opacity
+        property int sourceOpacityChanges: 0
+        onSourceOpacityChanged: ++sourceOpacityChanges
+    }
+}
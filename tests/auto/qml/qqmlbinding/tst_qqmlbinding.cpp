@@ -29,6 +29,9 @@
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
 #include <private/qqmlbind_p.h>
+#include <private/qqmlengine_p.h>
+#include <private/qqmlcomponent_p.h>
+#include <QtCore/qregularexpression.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include "../../shared/util.h"
 
@@ -50,6 +53,10 @@ private slots:
     void disabledOnUnknownProperty();
     void disabledOnReadonlyProperty();
     void delayed();
+    void deferredUpdates();
+    void deferredBindingLoop();
+    void propertyReadBindings();
+    void changingDependencies();
 
 private:
     QQmlEngine engine;
@@ -303,6 +310,141 @@ void tst_qqmlbinding::delayed()
     delete item;
 }
 
+void tst_qqmlbinding::deferredUpdates()
+{
+    QQmlEngine engine;
+    QQmlEnginePrivate::get(&engine)->deferBindingUpdates = true;
+    QQmlComponent c(&engine, testFileUrl("deferredUpdates.qml"));
+    QScopedPointer<QObject> object(c.create());
+    QVERIFY(!object.isNull());
+
+    QCOMPARE(object->property("sum").toInt(), 5);
+    const int sumChangeCount = object->property("sumChangeCount").toInt();
+
+    QMetaObject::invokeMethod(object.data(), "updateSource");
+    // doesn't update immediately
+    QCOMPARE(object->property("sum").toInt(), 5);
+
+    QCoreApplication::processEvents();
+    // sum depends on source twice, but is only evaluated with both new inputs
+    QCOMPARE(object->property("left").toInt(), 4);
+    QCOMPARE(object->property("right").toInt(), 6);
+    QCOMPARE(object->property("sum").toInt(), 10);
+    QCOMPARE(object->property("sumChangeCount").toInt(), sumChangeCount + 1);
+}
+
+void tst_qqmlbinding::deferredBindingLoop()
+{
+    QQmlEngine engine;
+    QQmlEnginePrivate::get(&engine)->deferBindingUpdates = true;
+    QQmlComponent c(&engine, testFileUrl("deferredBindingLoop.qml"));
+    QScopedPointer<QObject> object(c.create());
+    QVERIFY(!object.isNull());
+
+    // creating the objects already started the loop, either binding can hit the limit first
+    const QString warning = c.url().toString()
+            + QLatin1String(":3:1: QML QtObject: Binding loop detected for property \"");
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QRegularExpression::escape(warning)
+                                                          + QLatin1String("(pingPong|pong)\"")));
+    QCoreApplication::processEvents();
+
+    // the loop is reported and dropped instead of continuing in the next pass
+    const int pingPong = object->property("pingPong").toInt();
+    QCoreApplication::processEvents();
+    QCOMPARE(object->property("pingPong").toInt(), pingPong);
+
+    QTest::ignoreMessage(QtWarningMsg, qPrintable(warning + QLatin1String("pingPong\"")));
+    object->setProperty("pong", 100);
+    QCoreApplication::processEvents();
+    QVERIFY(object->property("pingPong").toInt() > 100);
+}
+
+static const QV4::CompiledData::Binding *compiledBinding(QQmlComponent *component, const QString &propertyName)
+{
+    QV4::CompiledData::CompilationUnit *unit = QQmlComponentPrivate::get(component)->compilationUnit;
+    const QV4::CompiledData::Object *root = unit->objectAt(unit->rootObjectIndex());
+    for (const QV4::CompiledData::Binding *binding = root->bindingsBegin(); binding != root->bindingsEnd(); ++binding) {
+        if (unit->stringAt(binding->propertyNameIndex) == propertyName)
+            return binding;
+    }
+    return 0;
+}
+
+void tst_qqmlbinding::propertyReadBindings()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("propertyReadBindings.qml"));
+    QScopedPointer<QObject> object(c.create());
+    QVERIFY(!object.isNull());
+
+    const QV4::CompiledData::Binding *binding = compiledBinding(&c, QStringLiteral("countCopy"));
+    QVERIFY(binding);
+    QVERIFY(binding->flags & QV4::CompiledData::Binding::IsPropertyReadBinding);
+    QCOMPARE(quint32(binding->value.propertyRead.sourceIdIndex), quint32(QV4::CompiledData::Binding::NoSourceId));
+    for (const char *name : {"label", "tint", "sourceWidth"}) {
+        binding = compiledBinding(&c, QLatin1String(name));
+        QVERIFY2(binding, name);
+        QVERIFY2(binding->flags & QV4::CompiledData::Binding::IsPropertyReadBinding, name);
+        QVERIFY2(binding->value.propertyRead.sourceIdIndex != QV4::CompiledData::Binding::NoSourceId, name);
+    }
+    binding = compiledBinding(&c, QStringLiteral("scaledWidth"));
+    QVERIFY(binding);
+    QVERIFY(!(binding->flags & QV4::CompiledData::Binding::IsPropertyReadBinding));
+
+    QObject *source = object->findChild<QObject *>("source");
+    QVERIFY(source);
+
+    QCOMPARE(object->property("countCopy").toInt(), 1);
+    QCOMPARE(object->property("label").toString(), QLatin1String("a"));
+    QCOMPARE(object->property("tint").value<QColor>(), QColor("red"));
+    QCOMPARE(object->property("sourceWidth").toReal(), qreal(10));
+    QCOMPARE(object->property("scaledWidth").toReal(), qreal(20));
+
+    // The pending binding on the source is evaluated before it is read, so the copy never
+    // sees the default opacity of 1.
+    QObject *reader = object->findChild<QObject *>("reader");
+    QVERIFY(reader);
+    QCOMPARE(reader->property("sourceOpacity").toReal(), qreal(0.25));
+    QCOMPARE(reader->property("sourceOpacityChanges").toInt(), 1);
+
+    object->setProperty("count", 2);
+    source->setProperty("text", QLatin1String("b"));
+    source->setProperty("color", QColor("blue"));
+    source->setProperty("width", 15);
+
+    QCOMPARE(object->property("countCopy").toInt(), 2);
+    QCOMPARE(object->property("label").toString(), QLatin1String("b"));
+    QCOMPARE(object->property("tint").value<QColor>(), QColor("blue"));
+    QCOMPARE(object->property("sourceWidth").toReal(), qreal(15));
+    QCOMPARE(object->property("scaledWidth").toReal(), qreal(30));
+}
+
+void tst_qqmlbinding::changingDependencies()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("changingDependencies.qml"));
+    QScopedPointer<QObject> object(c.create());
+    QVERIFY(!object.isNull());
+
+    QCOMPARE(object->property("result").toInt(), 6);
+
+    // switching paths back and forth must keep all dependencies subscribed
+    for (int i = 0; i < 3; ++i) {
+        object->setProperty("useExtra", true);
+        QCOMPARE(object->property("result").toInt(), 16 + i);
+        object->setProperty("extra", 20);
+        QCOMPARE(object->property("result").toInt(), 26 + i);
+        object->setProperty("extra", 10);
+        object->setProperty("useExtra", false);
+        QCOMPARE(object->property("result").toInt(), 6 + i);
+        object->setProperty("b", 3 + i);
+        QCOMPARE(object->property("result").toInt(), 7 + i);
+        object->setProperty("a", 0);
+        QCOMPARE(object->property("result").toInt(), 6 + i);
+        object->setProperty("a", 1);
+    }
+}
+
 QTEST_MAIN(tst_qqmlbinding)
 
 #include "tst_qqmlbinding.moc"
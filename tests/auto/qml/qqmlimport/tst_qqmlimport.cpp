@@ -28,6 +28,7 @@
 
 #include <QtTest/QtTest>
 #include <QQmlApplicationEngine>
+#include <QtQml/qqmlcomponent.h>
 #include <QtQuick/qquickview.h>
 #include <QtQuick/qquickitem.h>
 #include <private/qqmlimport_p.h>
@@ -43,6 +44,7 @@ private slots:
     void uiFormatLoading();
     void completeQmldirPaths_data();
     void completeQmldirPaths();
+    void persistentResolutionCache();
     void cleanup();
 };
 
@@ -185,6 +187,89 @@ void tst_QQmlImport::completeQmldirPaths()
     QCOMPARE(QQmlImports::completeQmldirPaths(uri, basePaths, majorVersion, minorVersion), expectedPaths);
 }
 
+static bool writeFile(const QString &fileName, const QByteArray &contents)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && file.write(contents) == contents.size();
+}
+
+static QObject *createCachedItem(QQmlEngine *engine, const QString &version, const QUrl &url)
+{
+    QQmlComponent component(engine);
+    component.setData("import Cached.Module " + version.toUtf8() + "\nCachedItem {}\n", url);
+    if (!component.isReady()) {
+        qWarning() << component.errorString();
+        return 0;
+    }
+    return component.create();
+}
+
+void tst_QQmlImport::persistentResolutionCache()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/qmlcache"));
+    for (const QString &fileName : cacheDir.entryList(QStringList("imports-*.cache"), QDir::Files))
+        QVERIFY(cacheDir.remove(fileName));
+
+    QTemporaryDir importDir;
+    QVERIFY(importDir.isValid());
+    QTemporaryDir otherImportDir;
+    QVERIFY(otherImportDir.isValid());
+    const QString modulePath = importDir.path() + "/Cached/Module";
+    QVERIFY(QDir().mkpath(modulePath));
+    QVERIFY(writeFile(modulePath + "/qmldir", "module Cached.Module\nCachedItem 1.0 CachedItem.qml\nCachedItem 1.1 CachedItem.qml\n"));
+    QVERIFY(writeFile(modulePath + "/CachedItem.qml", "import QtQml 2.0\nQtObject { property int value: 42 }\n"));
+
+    const QUrl url = testFileUrl("persistentResolutionCache.qml");
+    qputenv("QML_IMPORT_CACHE", "1");
+    {
+        QQmlEngine engine;
+        engine.addImportPath(importDir.path());
+        QScopedPointer<QObject> first(createCachedItem(&engine, "1.0", url));
+        QVERIFY(!first.isNull());
+        QCOMPARE(first->property("value").toInt(), 42);
+        QScopedPointer<QObject> second(createCachedItem(&engine, "1.1", url));
+        QVERIFY(!second.isNull());
+        QCOMPARE(second->property("value").toInt(), 42);
+    }
+    // The engine stored the location of the module when it was destroyed.
+    QCOMPARE(cacheDir.entryList(QStringList("imports-*.cache"), QDir::Files).count(), 1);
+
+    // Install a versioned copy of the module that the probing would prefer. It is created below
+    // Cached, so the modification time of the import directory stays the same.
+    const QString versionedModulePath = importDir.path() + "/Cached/Module.1";
+    QVERIFY(QDir().mkpath(versionedModulePath));
+    QVERIFY(writeFile(versionedModulePath + "/qmldir", "module Cached.Module\nCachedItem 1.0 CachedItem.qml\nCachedItem 1.1 CachedItem.qml\n"));
+    QVERIFY(writeFile(versionedModulePath + "/CachedItem.qml", "import QtQml 2.0\nQtObject { property int value: 43 }\n"));
+
+    {
+        QQmlEngine engine;
+        engine.addImportPath(importDir.path());
+
+        // Served from the cache, without probing the directories.
+        QScopedPointer<QObject> cached(createCachedItem(&engine, "1.0", url));
+        QVERIFY(!cached.isNull());
+        QCOMPARE(cached->property("value").toInt(), 42);
+
+        // Changing the import paths drops the cache, so the next lookup probes again.
+        engine.addImportPath(otherImportDir.path());
+        QScopedPointer<QObject> probed(createCachedItem(&engine, "1.1", url));
+        QVERIFY(!probed.isNull());
+        QCOMPARE(probed->property("value").toInt(), 43);
+    }
+    qunsetenv("QML_IMPORT_CACHE");
+
+    {
+        // Without QML_IMPORT_CACHE the directories are always probed.
+        QQmlEngine engine;
+        engine.addImportPath(importDir.path());
+        QScopedPointer<QObject> probed(createCachedItem(&engine, "1.0", url));
+        QVERIFY(!probed.isNull());
+        QCOMPARE(probed->property("value").toInt(), 43);
+    }
+    QStandardPaths::setTestModeEnabled(false);
+}
+
 QTEST_MAIN(tst_QQmlImport)
 
 #include "tst_qqmlimport.moc"
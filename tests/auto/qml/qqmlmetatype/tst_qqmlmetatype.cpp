@@ -32,6 +32,7 @@
 #include <qqmlprivate.h>
 #include <qqmlengine.h>
 #include <qqmlcomponent.h>
+#include <qthread.h>
 
 #include <private/qqmlmetatype_p.h>
 #include <private/qqmlpropertyvalueinterceptor_p.h>
@@ -56,6 +57,8 @@ private slots:
     void registrationType();
     void compositeType();
     void externalEnums();
+    void lookupsAfterRegistration();
+    void interleavedRegistrationsAndLookups();
 
     void isList();
 
@@ -83,6 +86,24 @@ class TestType3 : public QObject
     Q_OBJECT
 };
 
+class TestType4 : public QObject
+{
+    Q_OBJECT
+};
+
+class TypeLookupThread : public QThread
+{
+public:
+    void run() override
+    {
+        QQmlTypeModule *module = QQmlMetaType::typeModule(QStringLiteral("LookupTest"), 1);
+        found = module && module->type(QHashedStringRef(QStringLiteral("TestType4")), 1)
+                && QQmlMetaType::isModule(QStringLiteral("LookupTest"), 1, 1);
+    }
+
+    bool found = false;
+};
+
 class ExternalEnums : public QObject
 {
     Q_OBJECT
@@ -249,6 +270,51 @@ void tst_qqmlmetatype::prettyTypeName()
     QCOMPARE(QQmlMetaType::prettyTypeName(&obj3), QString("OtherName"));
 }
 
+void tst_qqmlmetatype::lookupsAfterRegistration()
+{
+    QVERIFY(qmlRegisterType<TestType3>("LookupTest", 1, 0, "TestType3") >= 0);
+
+    QQmlTypeModule *module = QQmlMetaType::typeModule(QStringLiteral("LookupTest"), 1);
+    QVERIFY(module);
+    QVERIFY(module->type(QHashedStringRef(QStringLiteral("TestType3")), 0));
+    QVERIFY(!module->type(QHashedStringRef(QStringLiteral("TestType4")), 1));
+    QVERIFY(!QQmlMetaType::isModule(QStringLiteral("LookupTest"), 1, 1));
+    QVERIFY(!QQmlMetaType::qmlType(&TestType4::staticMetaObject));
+
+    // types registered after a lookup must be found by later lookups, on any thread
+    const int index = qmlRegisterType<TestType4>("LookupTest", 1, 1, "TestType4");
+    QVERIFY(index >= 0);
+    QCOMPARE(QQmlMetaType::qmlTypeFromIndex(index), QQmlMetaType::qmlType(&TestType4::staticMetaObject));
+    QVERIFY(module->type(QHashedStringRef(QStringLiteral("TestType4")), 1));
+    QVERIFY(!module->type(QHashedStringRef(QStringLiteral("TestType4")), 0));
+    QVERIFY(QQmlMetaType::isModule(QStringLiteral("LookupTest"), 1, 1));
+
+    TypeLookupThread thread;
+    thread.start();
+    QVERIFY(thread.wait());
+    QVERIFY(thread.found);
+}
+
+void tst_qqmlmetatype::interleavedRegistrationsAndLookups()
+{
+    // like the type loader does for composite types: every registration is looked up right away
+    for (int i = 0; i < 500; ++i) {
+        const QString name = QStringLiteral("Interleaved") + QString::number(i);
+        const QUrl url(QStringLiteral("file:///interleaved/") + name + QStringLiteral(".qml"));
+        const int index = qmlRegisterType(url, "InterleavedTest", 1, 0, qPrintable(name));
+        QVERIFY(index >= 0);
+        QQmlType *type = QQmlMetaType::qmlTypeFromIndex(index);
+        QVERIFY(type);
+        QCOMPARE(type->elementName(), name);
+        QCOMPARE(QQmlMetaType::qmlType(url, true), type);
+    }
+
+    QQmlTypeModule *module = QQmlMetaType::typeModule(QStringLiteral("InterleavedTest"), 1);
+    QVERIFY(module);
+    for (int i = 0; i < 500; ++i)
+        QVERIFY(module->type(QHashedStringRef(QStringLiteral("Interleaved") + QString::number(i)), 0));
+}
+
 void tst_qqmlmetatype::isList()
 {
     QCOMPARE(QQmlMetaType::isList(QVariant::Invalid), false);
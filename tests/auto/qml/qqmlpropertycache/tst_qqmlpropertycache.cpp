@@ -30,6 +30,7 @@
 #include <private/qqmlpropertycache_p.h>
 #include <QtQml/qqmlengine.h>
 #include <private/qv8engine_p.h>
+#include <private/qv4scopedvalue_p.h>
 #include <private/qmetaobjectbuilder_p.h>
 #include <QCryptographicHash>
 #include "../../shared/util.h"
@@ -43,6 +44,7 @@ public:
 private slots:
     void properties();
     void propertiesDerived();
+    void propertiesByV4String();
     void methods();
     void methodsDerived();
     void signalHandlers();
@@ -147,6 +149,35 @@ void tst_qqmlpropertycache::propertiesDerived()
     QCOMPARE(data->coreIndex(), metaObject->indexOfProperty("propertyD"));
 }
 
+void tst_qqmlpropertycache::propertiesByV4String()
+{
+    QQmlEngine engine;
+    QV4::ExecutionEngine *v4 = QV8Engine::getV4(&engine);
+    DerivedObject object;
+    const QMetaObject *metaObject = object.metaObject();
+
+    QQmlRefPointer<QQmlPropertyCache> parentCache(new QQmlPropertyCache(v4, metaObject));
+    QQmlRefPointer<QQmlPropertyCache> cache(parentCache->copyAndReserve(1, 0, 0));
+    cache->appendProperty(QStringLiteral("propertyE"), QQmlPropertyData::IsWritable,
+                          metaObject->propertyCount(), QMetaType::Int, -1);
+
+    QV4::Scope scope(v4);
+    QV4::ScopedString name(scope);
+    QQmlPropertyData *data;
+
+    // names from the meta-object are stored as Latin-1, appended ones as QString
+    name = v4->newString(QStringLiteral("propertyB"));
+    QVERIFY((data = cache->property(name.getPointer(), 0, 0)));
+    QCOMPARE(data->coreIndex(), metaObject->indexOfProperty("propertyB"));
+
+    name = v4->newString(QStringLiteral("propertyE"));
+    QVERIFY((data = cache->property(name.getPointer(), 0, 0)));
+    QCOMPARE(data->coreIndex(), metaObject->propertyCount());
+
+    name = v4->newString(QStringLiteral("propertyF"));
+    QVERIFY(!cache->property(name.getPointer(), 0, 0));
+}
+
 void tst_qqmlpropertycache::methods()
 {
     QQmlEngine engine;
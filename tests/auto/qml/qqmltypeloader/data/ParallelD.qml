@@ -0,0 +1,6 @@
+import QtQml 2.0
+
+QtObject {
+    property string name: "D"
+    property int weight: name.charCodeAt(0) - 64
+}
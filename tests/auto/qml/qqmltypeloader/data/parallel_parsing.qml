@@ -0,0 +1,9 @@
+import QtQml 2.0
+
+QtObject {
+    property QtObject a: ParallelA {}
+    property QtObject b: ParallelB {}
+    property QtObject c: ParallelC {}
+    property QtObject d: ParallelD {}
+    property int total: a.weight + b.weight + c.weight + d.weight
+}
@@ -0,0 +1,6 @@
+import QtQml 2.0
+
+QtObject {
+    property QtObject a: ParallelA {}
+    property QtObject broken: ParallelBroken {}
+}
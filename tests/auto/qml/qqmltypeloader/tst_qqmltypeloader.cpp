@@ -32,6 +32,7 @@
 #include <QtQuick/qquickitem.h>
 #include <QtQml/private/qqmlengine_p.h>
 #include <QtQml/private/qqmltypeloader_p.h>
+#include <QtQml/private/qqmlstartuptrace_p.h>
 #include "../../shared/util.h"
 
 class tst_QQMLTypeLoader : public QQmlDataTest
@@ -39,12 +40,25 @@ class tst_QQMLTypeLoader : public QQmlDataTest
     Q_OBJECT
 
 private slots:
+    void initTestCase();
     void testLoadComplete();
     void loadComponentSynchronously();
     void trimCache();
     void trimCache2();
+    void parallelParsing();
+    void synchronousLoadWithParserPool();
+    void startupTrace();
 };
 
+void tst_QQMLTypeLoader::initTestCase()
+{
+    // parallelParsing and synchronousLoadWithParserPool have to see the documents parsed,
+    // not loaded from .qmlc files left behind by an earlier run. The variable is only read
+    // once per process, so it has to be set before anything is loaded.
+    qputenv("QML_DISABLE_DISK_CACHE", "1");
+    QQmlDataTest::initTestCase();
+}
+
 void tst_QQMLTypeLoader::testLoadComplete()
 {
     QQuickView *window = new QQuickView();
@@ -120,6 +134,83 @@ void tst_QQMLTypeLoader::trimCache2()
     QCOMPARE(loader.isTypeLoaded(testFileUrl("MyComponent2.qml")), false);
 }
 
+void tst_QQMLTypeLoader::parallelParsing()
+{
+    QQmlEngine engine;
+
+    QQmlComponent component(&engine, testFileUrl("parallel_parsing.qml"), QQmlComponent::Asynchronous);
+    QTRY_VERIFY(component.isReady() || component.isError());
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+    QScopedPointer<QObject> o(component.create());
+    QVERIFY(o);
+    QCOMPARE(o->property("total").toInt(), 10);
+
+    // Errors found while parsing a dependency have to reach the component that needs it.
+    QQmlComponent broken(&engine, testFileUrl("parallel_parsing_error.qml"), QQmlComponent::Asynchronous);
+    QTRY_VERIFY(broken.isReady() || broken.isError());
+    QVERIFY(broken.isError());
+    QVERIFY(broken.errorString().contains(QLatin1String("ParallelBroken")));
+}
+
+void tst_QQMLTypeLoader::synchronousLoadWithParserPool()
+{
+    QQmlEngine engine;
+
+    // Local files are still loaded within the constructor, dependencies included.
+    QQmlComponent component(&engine, testFileUrl("parallel_parsing.qml"));
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+    QScopedPointer<QObject> o(component.create());
+    QVERIFY(o);
+    QCOMPARE(o->property("total").toInt(), 10);
+
+    QQmlComponent fromData(&engine);
+    fromData.setData("import QtQml 2.0\nQtObject { property QtObject a: ParallelA {} }",
+                     testFileUrl("fromData.qml"));
+    QVERIFY2(fromData.isReady(), qPrintable(fromData.errorString()));
+
+    // A synchronous request for a document that is still being loaded in the background
+    // waits for it.
+    QQmlComponent async(&engine, testFileUrl("parallel_parsing_error.qml"), QQmlComponent::Asynchronous);
+    QQmlComponent sync(&engine, testFileUrl("parallel_parsing_error.qml"));
+    QVERIFY(sync.isError());
+    QVERIFY(sync.errorString().contains(QLatin1String("ParallelBroken")));
+}
+
+void tst_QQMLTypeLoader::startupTrace()
+{
+    QQmlStartupTrace::start(QString());
+    {
+        QQmlEngine engine;
+        QQmlComponent component(&engine, testFileUrl("startup_trace.qml"));
+        QScopedPointer<QObject> o(component.create());
+        QVERIFY2(o, qPrintable(component.errorString()));
+        QCOMPARE(o->property("value").toInt(), 42);
+    }
+    const QByteArray json = QQmlStartupTrace::toChromeTraceJson();
+    QQmlStartupTrace::stop();
+
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(json, &parseError);
+    QCOMPARE(parseError.error, QJsonParseError::NoError);
+
+    const QString url = testFileUrl("startup_trace.qml").toString();
+    QSet<QString> phases;
+    for (const QJsonValue &value : document.object().value(QLatin1String("traceEvents")).toArray()) {
+        const QJsonObject event = value.toObject();
+        if (event.value(QLatin1String("args")).toObject().value(QLatin1String("url")).toString() == url)
+            phases.insert(event.value(QLatin1String("name")).toString());
+    }
+
+    // The document is either compiled or taken from the disk cache, depending on earlier runs.
+    QVERIFY(phases.contains(QLatin1String("Compile")) || phases.contains(QLatin1String("DiskCacheHit")));
+    QVERIFY(phases.contains(QLatin1String("Create")));
+    QVERIFY(phases.contains(QLatin1String("Finalize")));
+
+    const QJsonObject otherData = document.object().value(QLatin1String("otherData")).toObject();
+    QVERIFY(otherData.contains(QLatin1String("diskCacheHits")));
+    QVERIFY(otherData.contains(QLatin1String("diskCacheMisses")));
+}
+
 QTEST_MAIN(tst_QQMLTypeLoader)
 
 #include "tst_qqmltypeloader.moc"
@@ -0,0 +1,9 @@
+WorkerScript.onMessage = function(msg) {
+    if (msg.model === undefined) {
+        WorkerScript.sendMessage({ count: -1 })
+        return
+    }
+    msg.model.append({ value: msg.value })
+    msg.model.sync()
+    WorkerScript.sendMessage({ count: msg.model.count })
+}
@@ -0,0 +1,25 @@
+import QtQuick 2.0
+
+Item {
+    id: root
+    property int firstCount: 0
+    property int secondCount: 0
+    property alias model: listModel
+
+    ListModel { id: listModel }
+
+    WorkerScript {
+        id: first
+        source: "script_listmodel.js"
+        onMessage: root.firstCount = messageObject.count
+    }
+
+    WorkerScript {
+        id: second
+        source: "script_listmodel.js"
+        onMessage: root.secondCount = messageObject.count
+    }
+
+    function sendToFirst(value) { first.sendMessage({ model: listModel, value: value }) }
+    function sendToSecond(value) { second.sendMessage({ model: listModel, value: value }) }
+}
@@ -30,6 +30,7 @@
 #include <QtCore/qtimer.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
+#include <QtCore/qabstractitemmodel.h>
 #include <QtQml/qjsengine.h>
 
 #include <QtQml/qqmlcomponent.h>
@@ -59,6 +60,8 @@ private slots:
     void script_var();
     void script_global();
     void stressDispose();
+    void workerThreadPool();
+    void sharedListModel();
 
 private:
     void waitForEchoMessage(QQuickWorkerScript *worker) {
@@ -365,6 +368,77 @@ void tst_QQuickWorkerScript::stressDispose()
     }
 }
 
+void tst_QQuickWorkerScript::workerThreadPool()
+{
+    {
+        // All workers share one thread unless the pool is enabled.
+        QQmlEngine engine;
+        QQmlComponent component(&engine, testFileUrl("worker.qml"));
+        QScopedPointer<QObject> first(component.create());
+        QVERIFY(first);
+        QScopedPointer<QObject> second(component.create());
+        QVERIFY(second);
+        QCOMPARE(QQmlEnginePrivate::get(&engine)->workerScriptEngines.count(), 1);
+    }
+
+    qputenv("QML_WORKERSCRIPT_MAX_THREADS", "2");
+    QQmlEngine engine;
+    QQmlEnginePrivate *enginePrivate = QQmlEnginePrivate::get(&engine);
+
+    QQmlComponent component(&engine, testFileUrl("worker.qml"));
+    QScopedPointer<QQuickWorkerScript> first(qobject_cast<QQuickWorkerScript*>(component.create()));
+    QVERIFY(first);
+    QScopedPointer<QQuickWorkerScript> second(qobject_cast<QQuickWorkerScript*>(component.create()));
+    qunsetenv("QML_WORKERSCRIPT_MAX_THREADS");
+    QVERIFY(second);
+
+    const int expectedThreads = 2;
+    QCOMPARE(enginePrivate->workerScriptEngines.count(), expectedThreads);
+
+    // Both workers must still answer, whichever thread they ended up on.
+    const QMetaObject *mo = first->metaObject();
+    QVariant value(42);
+    QVERIFY(QMetaObject::invokeMethod(first.data(), "testSend", Q_ARG(QVariant, value)));
+    waitForEchoMessage(first.data());
+    QCOMPARE(mo->property(mo->indexOfProperty("response")).read(first.data()).value<QVariant>(), value);
+    QVERIFY(QMetaObject::invokeMethod(second.data(), "testSend", Q_ARG(QVariant, value)));
+    waitForEchoMessage(second.data());
+    QCOMPARE(mo->property(mo->indexOfProperty("response")).read(second.data()).value<QVariant>(), value);
+
+    // A worker created after one was removed reuses the idle thread.
+    first.reset();
+    QScopedPointer<QQuickWorkerScript> third(qobject_cast<QQuickWorkerScript*>(component.create()));
+    QVERIFY(third);
+    QCOMPARE(enginePrivate->workerScriptEngines.count(), expectedThreads);
+
+    qApp->processEvents();
+}
+
+void tst_QQuickWorkerScript::sharedListModel()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("worker_listmodel.qml"));
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY2(root, qPrintable(component.errorString()));
+    QCOMPARE(QQmlEnginePrivate::get(&engine)->workerScriptEngines.count(), 1);
+
+    QAbstractItemModel *model = qobject_cast<QAbstractItemModel *>(qvariant_cast<QObject *>(root->property("model")));
+    QVERIFY(model);
+
+    // Both workers get the same model and see each other's changes.
+    QVERIFY(QMetaObject::invokeMethod(root.data(), "sendToFirst", Q_ARG(QVariant, 1)));
+    QTRY_COMPARE(root->property("firstCount").toInt(), 1);
+    QCOMPARE(model->rowCount(), 1);
+
+    QVERIFY(QMetaObject::invokeMethod(root.data(), "sendToSecond", Q_ARG(QVariant, 2)));
+    QTRY_COMPARE(root->property("secondCount").toInt(), 2);
+    QCOMPARE(model->rowCount(), 2);
+
+    QVERIFY(QMetaObject::invokeMethod(root.data(), "sendToFirst", Q_ARG(QVariant, 3)));
+    QTRY_COMPARE(root->property("firstCount").toInt(), 3);
+    QCOMPARE(model->rowCount(), 3);
+}
+
 QTEST_MAIN(tst_QQuickWorkerScript)
 
 #include "tst_qquickworkerscript.moc"
@@ -29,6 +29,8 @@
 #include <qtest.h>
 #include <QQmlEngine>
 #include <private/qv4mm_p.h>
+#include <private/qv8engine_p.h>
+#include <private/qv4object_p.h>
 
 class tst_qv4mm : public QObject
 {
@@ -37,6 +39,13 @@ class tst_qv4mm : public QObject
 private slots:
     void gcStats();
     void tweaks();
+    void generationalGC();
+    void incrementalGC();
+    void lazySweep();
+    void lazySweepWithAllocatingDestroy();
+    void releaseEmptyChunks();
+    void gcStatistics();
+    void gcStatisticsWithLazySweep();
 };
 
 void tst_qv4mm::gcStats()
@@ -44,6 +53,8 @@ void tst_qv4mm::gcStats()
     qputenv(QV4_MM_STATS, "1");
     QQmlEngine engine;
     engine.collectGarbage();
+    // printing the statistics makes every collection sweep eagerly
+    qunsetenv(QV4_MM_STATS);
 }
 
 void tst_qv4mm::tweaks()
@@ -51,6 +62,289 @@ void tst_qv4mm::tweaks()
     qputenv(QV4_MM_MAXBLOCK_SHIFT, "5");
     qputenv(QV4_MM_MAX_CHUNK_SIZE, "65536");
     QQmlEngine engine;
+    qunsetenv(QV4_MM_MAXBLOCK_SHIFT);
+    qunsetenv(QV4_MM_MAX_CHUNK_SIZE);
+}
+
+void tst_qv4mm::generationalGC()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = QV8Engine::getV4(&engine)->memoryManager;
+    if (!mm->generationalGC)
+        QSKIP("Generational collections need a build with the qml-generational-gc feature");
+
+    engine.evaluate(QStringLiteral(
+            "var holder = { items: [] };\n"
+            "function churn(start, n) {\n"
+            "    for (var i = start; i < start + n; ++i) {\n"
+            "        var o = { value: i, garbage: [i, i + 1, 'x' + i] };\n"
+            "        if (i % 1000 == 0)\n"
+            "            holder.items.push(o);\n"
+            "    }\n"
+            "}"));
+    QJSValue churn = engine.globalObject().property(QStringLiteral("churn"));
+    // holder survives this collection and becomes old
+    engine.collectGarbage();
+
+    // young objects stored into an old one have to survive the minor collections
+    // triggered by the allocations
+    quint64 lastSequenceNumber = mm->lastGCStatistics().sequenceNumber;
+    int minorCollections = 0;
+    for (int start = 0; start < 100000; start += 1000) {
+        churn.call(QJSValueList() << start << 1000);
+        const QV4::GCStatistics &stats = mm->lastGCStatistics();
+        if (stats.sequenceNumber != lastSequenceNumber && stats.minorCollection)
+            ++minorCollections;
+        lastSequenceNumber = stats.sequenceNumber;
+    }
+    QVERIFY(minorCollections > 0);
+
+    QJSValue sum = engine.evaluate(QStringLiteral(
+            "var sum = 0;\n"
+            "for (var j = 0; j < holder.items.length; ++j)\n"
+            "    sum += holder.items[j].value;\n"
+            "sum"));
+    QVERIFY(!sum.isError());
+    QCOMPARE(sum.toInt(), 4950000);
+    QCOMPARE(engine.evaluate(QStringLiteral("holder.items.length")).toInt(), 100);
+}
+
+void tst_qv4mm::incrementalGC()
+{
+    qputenv(QV4_MM_INCREMENTAL_GC, "50");
+    QJSEngine engine;
+    qunsetenv(QV4_MM_INCREMENTAL_GC);
+
+    QV4::MemoryManager *mm = QV8Engine::getV4(&engine)->memoryManager;
+    if (!mm->isIncrementalGCEnabled())
+        QSKIP("Incremental marking needs a build with the qml-generational-gc feature");
+
+    engine.evaluate(QStringLiteral(
+            "var holder = { items: [] };\n"
+            "function churn(n) {\n"
+            "    for (var i = 0; i < n; ++i) {\n"
+            "        var o = { value: i, garbage: [i, 'x' + i] };\n"
+            "        if (i % 1000 == 0)\n"
+            "            holder.items.push(o);\n"
+            "    }\n"
+            "}"));
+    QJSValue churn = engine.globalObject().property(QStringLiteral("churn"));
+
+    // interleave the mutator with mark steps, like the frame driven steps do
+    bool sawIncrementalGC = false;
+    int finishedIncrementalGCs = 0;
+    for (int round = 0; round < 100; ++round) {
+        churn.call(QJSValueList() << 10000);
+        sawIncrementalGC |= mm->isIncrementalGCRunning();
+        const quint64 sequenceNumber = mm->lastGCStatistics().sequenceNumber;
+        mm->runIncrementalGCStep();
+        const QV4::GCStatistics &stats = mm->lastGCStatistics();
+        if (stats.sequenceNumber != sequenceNumber && stats.incremental) {
+            // reports what started the collection, not the step that finished it
+            QCOMPARE(stats.trigger, QV4::GCStatistics::AllocationTrigger);
+            ++finishedIncrementalGCs;
+        }
+    }
+    QVERIFY(sawIncrementalGC);
+    if (finishedIncrementalGCs == 0) {
+        // the steps were too short to ever finish the marking, give one all the time it needs
+        for (int round = 0; round < 100 && !mm->isIncrementalGCRunning(); ++round)
+            churn.call(QJSValueList() << 10000);
+        QVERIFY(mm->isIncrementalGCRunning());
+        QVERIFY(mm->runIncrementalGCStep(10 * 1000 * 1000));
+        QVERIFY(!mm->isIncrementalGCRunning());
+        QVERIFY(mm->lastGCStatistics().incremental);
+        QCOMPARE(mm->lastGCStatistics().trigger, QV4::GCStatistics::AllocationTrigger);
+    }
+    engine.collectGarbage();
+    QVERIFY(!mm->isIncrementalGCRunning());
+
+    QJSValue sum = engine.evaluate(QStringLiteral(
+            "var sum = 0;\n"
+            "for (var j = 0; j < holder.items.length; ++j)\n"
+            "    sum += holder.items[j].value;\n"
+            "sum"));
+    QVERIFY(!sum.isError());
+    QCOMPARE(sum.toInt(), 4500000);
+}
+
+void tst_qv4mm::lazySweep()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = QV8Engine::getV4(&engine)->memoryManager;
+    if (!mm->lazySweep)
+        QSKIP("Lazy sweeping is disabled");
+
+    QJSValue churn = engine.evaluate(QStringLiteral(
+            "(function(n) {\n"
+            "    var keep = [];\n"
+            "    for (var i = 0; i < n; ++i) {\n"
+            "        var o = { value: i, text: 'x' + i };\n"
+            "        if (i % 100 == 0)\n"
+            "            keep.push(o);\n"
+            "    }\n"
+            "    return keep.length;\n"
+            "})"));
+    // collections triggered by allocations leave chunks for the allocator to sweep
+    int lazilySweptGCs = 0;
+    for (int round = 0; round < 250; ++round) {
+        const quint64 sequenceNumber = mm->lastGCStatistics().sequenceNumber;
+        QCOMPARE(churn.call(QJSValueList() << 2000).toInt(), 20);
+        if (mm->lastGCStatistics().sequenceNumber != sequenceNumber && mm->blockAllocator.hasChunksToSweep())
+            ++lazilySweptGCs;
+    }
+    QVERIFY(lazilySweptGCs > 0);
+
+    // explicit collections sweep everything right away
+    engine.collectGarbage();
+    QVERIFY(!mm->blockAllocator.hasChunksToSweep());
+
+    // chunks swept on demand by the allocator are reused for the same workload
+    const size_t allocated = mm->getAllocatedMem();
+    QCOMPARE(churn.call(QJSValueList() << 500000).toInt(), 5000);
+    QVERIFY(mm->getAllocatedMem() <= 2 * allocated);
+}
+
+QT_BEGIN_NAMESPACE
+
+namespace QV4 {
+
+namespace Heap {
+struct AllocatingSentinel : public Object {
+    void init(int *destroyCount)
+    {
+        Object::init();
+        this->destroyCount = destroyCount;
+    }
+
+    void destroy() {
+        // enough to run out of free slots while the allocator sweeps this chunk
+        for (int i = 0; i < 64; ++i)
+            internalClass->engine->newObject();
+        ++*destroyCount;
+        Object::destroy();
+    }
+
+    int *destroyCount;
+};
+} // namespace Heap
+
+struct AllocatingSentinel : public Object {
+    V4_OBJECT2(AllocatingSentinel, Object)
+    V4_NEEDS_DESTROY
+};
+
+} // namespace QV4
+
+QT_END_NAMESPACE
+
+DEFINE_OBJECT_VTABLE(QV4::AllocatingSentinel);
+
+void tst_qv4mm::lazySweepWithAllocatingDestroy()
+{
+    QJSEngine engine;
+    QV4::ExecutionEngine *v4 = QV8Engine::getV4(&engine);
+    QV4::MemoryManager *mm = v4->memoryManager;
+    if (!mm->lazySweep)
+        QSKIP("Lazy sweeping is disabled");
+
+    const int sentinels = 20000;
+    int destroyCount = 0;
+    for (int i = 0; i < sentinels; ++i)
+        mm->allocObject<QV4::AllocatingSentinel>(&destroyCount);
+
+    // A collection triggered by an allocation leaves the sentinels to the lazy sweep...
+    mm->blockAllocator.finishSweep();
+    const int destroyedBefore = destroyCount;
+    QVERIFY(destroyedBefore < sentinels);
+    mm->runGC(QV4::MemoryManager::MajorCollection, QV4::GCStatistics::AllocationTrigger);
+    QVERIFY(mm->blockAllocator.hasChunksToSweep());
+    QCOMPARE(destroyCount, destroyedBefore);
+
+    // ...which runs their destroy callbacks from within the allocator.
+    engine.evaluate(QStringLiteral("for (var i = 0; i < 500000; ++i) var o = { value: i, text: 'x' + i };"));
+    QVERIFY(destroyCount > destroyedBefore);
+
+    engine.collectGarbage();
+    QCOMPARE(destroyCount, sentinels);
+}
+
+void tst_qv4mm::releaseEmptyChunks()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = QV8Engine::getV4(&engine)->memoryManager;
+
+    engine.evaluate(QStringLiteral("var big = []; for (var i = 0; i < 200000; ++i) big.push({ value: i });"));
+    engine.collectGarbage();
+    const size_t peak = mm->blockAllocator.allocatedMem();
+
+    engine.evaluate(QStringLiteral("big = null;"));
+    engine.collectGarbage();
+    QVERIFY(mm->blockAllocator.releasedChunks > 0);
+    QVERIFY(mm->blockAllocator.allocatedMem() < peak);
+}
+
+void tst_qv4mm::gcStatistics()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = QV8Engine::getV4(&engine)->memoryManager;
+
+    engine.evaluate(QStringLiteral("var big = []; for (var i = 0; i < 100000; ++i) big.push({ value: i });"));
+    const quint64 collections = mm->lastGCStatistics().sequenceNumber;
+    engine.evaluate(QStringLiteral("big = null;"));
+    engine.collectGarbage();
+
+    const QV4::GCStatistics &stats = mm->lastGCStatistics();
+    QCOMPARE(stats.sequenceNumber, collections + 1);
+    QCOMPARE(stats.trigger, QV4::GCStatistics::ExplicitTrigger);
+    QVERIFY(!stats.minorCollection);
+    QVERIFY(stats.markTime >= 0);
+    QVERIFY(stats.sweepTime >= 0);
+    QVERIFY(stats.usedAfter < stats.usedBefore);
+    QCOMPARE(stats.usedAfter, mm->getUsedMem());
+    QCOMPARE(stats.chunks, mm->blockAllocator.chunks.size());
+    QCOMPARE(stats.unmanagedHeapAfter, mm->unmanagedHeapSize);
+}
+
+void tst_qv4mm::gcStatisticsWithLazySweep()
+{
+    QJSEngine engine;
+    QV4::MemoryManager *mm = QV8Engine::getV4(&engine)->memoryManager;
+    if (!mm->lazySweep)
+        QSKIP("Lazy sweeping is disabled");
+
+    QJSValue churn = engine.evaluate(QStringLiteral(
+            "(function(n) {\n"
+            "    var keep = [];\n"
+            "    for (var i = 0; i < n; ++i) {\n"
+            "        var o = { value: i };\n"
+            "        if (i % 10 == 0)\n"
+            "            keep.push(o);\n"
+            "    }\n"
+            "    return keep.length;\n"
+            "})"));
+
+    // collections triggered by allocations report what they freed, even though the
+    // chunks get swept later
+    int allocationTriggeredGCs = 0;
+    for (int round = 0; round < 20; ++round) {
+        const quint64 sequenceNumber = mm->lastGCStatistics().sequenceNumber;
+        QCOMPARE(churn.call(QJSValueList() << 20000).toInt(), 2000);
+        const QV4::GCStatistics &stats = mm->lastGCStatistics();
+        if (stats.sequenceNumber == sequenceNumber)
+            continue;
+        QCOMPARE(stats.trigger, QV4::GCStatistics::AllocationTrigger);
+        QVERIFY(stats.usedAfter < stats.usedBefore);
+        ++allocationTriggeredGCs;
+    }
+    QVERIFY(allocationTriggeredGCs > 0);
+
+    // and that is what the heap holds once the sweep is done
+    mm->runGC(QV4::MemoryManager::MinorCollection, QV4::GCStatistics::AllocationTrigger);
+    QVERIFY(mm->blockAllocator.hasChunksToSweep());
+    const QV4::GCStatistics stats = mm->lastGCStatistics();
+    mm->blockAllocator.finishSweep();
+    QCOMPARE(stats.usedAfter, mm->getUsedMem());
 }
 
 QTEST_MAIN(tst_qv4mm)
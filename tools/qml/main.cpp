@@ -349,6 +349,7 @@ void printUsage()
     printf("\t-dummy-data [directory] ...... Load QML files from the given directory as context properties.\n");
     printf("\t-slow-animations ............. Run all animations in slow motion.\n");
     printf("\t-fixed-animations ............ Run animations off animation tick rather than wall time.\n");
+    printf("\t-startup-trace [file] ........ Write a Chrome trace of the QML loading phases to the given file on exit.\n");
     exit(0);
 }
 
@@ -362,6 +363,17 @@ void noFilesGiven()
 //Called before application initialization, removes arguments it uses
 void getAppFlags(int &argc, char **argv)
 {
+    for (int i=0; i<argc; i++) {
+        if (!strcmp(argv[i], "-startup-trace")) { // Must be done before the engine is created
+            const int used = (i+1 < argc) ? 2 : 1;
+            if (used == 2)
+                qputenv("QML_STARTUP_TRACE", argv[i+1]);
+            for (int j=i; j<argc-used; j++)
+                argv[j] = argv[j+used];
+            argc -= used;
+            --i;
+        }
+    }
 #ifdef QT_GUI_LIB
     for (int i=0; i<argc; i++) {
         if (!strcmp(argv[i], "-apptype")) { // Must be done before application, as it selects application
@@ -390,9 +402,6 @@ void getAppFlags(int &argc, char **argv)
             argc -= 2;
         }
     }
-#else
-    Q_UNUSED(argc)
-    Q_UNUSED(argv)
 #endif // QT_GUI_LIB
 }
 
@@ -33,6 +33,9 @@
 #include <QFileInfo>
 #include <QDateTime>
 #include <QHashFunctions>
+#include <QDir>
+#include <QMap>
+#include <QSaveFile>
 
 #include <private/qqmlirbuilder_p.h>
 #include <private/qv4isel_moth_p.h>
@@ -288,6 +291,82 @@ static bool compileJSFile(const QString &inputFileName, const QString &outputFil
     return true;
 }
 
+static bool createBundle(const QStringList &cacheFiles, const QString &outputFileName, const QString &rootPath, const QString &sourcePrefix, Error *error)
+{
+    // Sorted by the UTF-8 encoded source path, so that the loader can do a binary search.
+    QMap<QByteArray, QByteArray> units;
+    const QDir root(rootPath);
+    for (const QString &cacheFile: cacheFiles) {
+        QFile f(cacheFile);
+        if (!f.open(QIODevice::ReadOnly)) {
+            error->message = QLatin1String("Error opening ") + cacheFile + QLatin1Char(':') + f.errorString();
+            return false;
+        }
+        const QByteArray unit = f.readAll();
+        if (unit.size() < int(sizeof(QV4::CompiledData::Unit))
+                || strncmp(unit.constData(), QV4::CompiledData::magic_str, sizeof(QV4::CompiledData::Unit::magic))) {
+            error->message = cacheFile + QLatin1String(" is not a QML cache file");
+            return false;
+        }
+
+        QString sourceFile = root.relativeFilePath(cacheFile);
+        sourceFile.chop(1); // Foo.qmlc -> Foo.qml
+        units.insert((sourcePrefix + sourceFile).toUtf8(), unit);
+    }
+
+    const int unitAlignment = 16;
+    const auto align = [unitAlignment](quint32 offset) {
+        return (offset + unitAlignment - 1) & ~quint32(unitAlignment - 1);
+    };
+
+    QV4::CompiledData::UnitBundle header;
+    memcpy(header.magic, QV4::CompiledData::bundle_magic_str, sizeof(header.magic));
+    header.version = QV4_DATA_STRUCTURE_VERSION;
+    header.qtVersion = QT_VERSION;
+    header.entryCount = units.count();
+    header.offsetToEntries = sizeof(header);
+
+    QVector<QV4::CompiledData::UnitBundle::Entry> entries(units.count());
+    quint32 offset = sizeof(header) + entries.size() * sizeof(QV4::CompiledData::UnitBundle::Entry);
+    int i = 0;
+    for (auto it = units.cbegin(), end = units.cend(); it != end; ++it, ++i) {
+        entries[i].pathOffset = offset;
+        entries[i].pathSize = it.key().size();
+        offset += it.key().size();
+    }
+    i = 0;
+    for (auto it = units.cbegin(), end = units.cend(); it != end; ++it, ++i) {
+        offset = align(offset);
+        entries[i].unitOffset = offset;
+        entries[i].unitSize = it.value().size();
+        offset += it.value().size();
+    }
+
+    QSaveFile bundle(outputFileName);
+    if (!bundle.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error->message = bundle.errorString();
+        return false;
+    }
+
+    QByteArray data;
+    data.reserve(offset);
+    data.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    data.append(reinterpret_cast<const char *>(entries.constData()), entries.size() * sizeof(QV4::CompiledData::UnitBundle::Entry));
+    for (auto it = units.cbegin(), end = units.cend(); it != end; ++it)
+        data.append(it.key());
+    for (const QByteArray &unit: qAsConst(units)) {
+        data.append(QByteArray(align(data.size()) - data.size(), '\0'));
+        data.append(unit);
+    }
+
+    if (bundle.write(data) != data.size() || !bundle.commit()) {
+        error->message = bundle.errorString();
+        return false;
+    }
+
+    return true;
+}
+
 int main(int argc, char **argv)
 {
     // Produce reliably the same output for the same input by disabling QHash's random seeding.
@@ -313,11 +392,37 @@ int main(int argc, char **argv)
     QCommandLineOption checkIfSupportedOption(QStringLiteral("check-if-supported"), QCoreApplication::translate("main", "Check if cache generate is supported on the specified target architecture"));
     parser.addOption(checkIfSupportedOption);
 
+    QCommandLineOption bundleOption(QStringLiteral("bundle"), QCoreApplication::translate("main", "Pack the given cache files into a single bundle"));
+    parser.addOption(bundleOption);
+
+    QCommandLineOption bundleRootOption(QStringLiteral("bundle-root"), QCoreApplication::translate("main", "Directory the bundled cache files are relative to"), QCoreApplication::translate("main", "directory"));
+    parser.addOption(bundleRootOption);
+
+    QCommandLineOption bundlePrefixOption(QStringLiteral("bundle-prefix"), QCoreApplication::translate("main", "Path the bundled sources are loaded from at run-time"), QCoreApplication::translate("main", "prefix"));
+    parser.addOption(bundlePrefixOption);
+
     parser.addPositionalArgument(QStringLiteral("[qml file]"),
             QStringLiteral("QML source file to generate cache for."));
 
     parser.process(app);
 
+    if (parser.isSet(bundleOption)) {
+        if (!parser.isSet(outputFileOption)) {
+            fprintf(stderr, "No bundle file name specified. Please specify with -o <file name>\n");
+            return EXIT_FAILURE;
+        }
+
+        const QString rootPath = parser.isSet(bundleRootOption) ? parser.value(bundleRootOption) : QDir::currentPath();
+        const QString sourcePrefix = parser.isSet(bundlePrefixOption) ? parser.value(bundlePrefixOption) : QStringLiteral(":/");
+
+        Error error;
+        if (!createBundle(parser.positionalArguments(), parser.value(outputFileOption), rootPath, sourcePrefix, &error)) {
+            error.augment(QLatin1String("Error creating bundle: ")).print();
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
     if (!parser.isSet(targetArchitectureOption)) {
         fprintf(stderr, "Target architecture not specified. Please specify with --target-architecture=<arch>\n");
         parser.showHelp();